@@ -0,0 +1,103 @@
+// 比較 mmap 開啟與關閉時的點查詢與範圍掃描延遲
+// usage: TypeSQLite_MmapBenchmark [db_path] [size_mb] [lookups]
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include "../src/TypeSQlite.hpp"
+
+using namespace TypeSQLite;
+
+namespace {
+    Column<"id", DataType::INTEGER, ColumnPrimaryKey<> > IdColumn;
+    Column<"payload", DataType::BLOB> PayloadColumn;
+    auto BlobTableDefinition = MakeTableDefinition<"blobs">(std::make_tuple(IdColumn, PayloadColumn));
+    using BlobDatabase = Database<decltype(BlobTableDefinition)>;
+
+    constexpr int64_t PayloadSize = 1024;
+    constexpr int64_t RangeRows = 1000;
+
+    template<typename F>
+    double MeasureMicroseconds(int iterations, F &&f) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            f();
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+        return elapsed.count() / iterations;
+    }
+
+    void Populate(const std::string &path, int64_t rows) {
+        BlobDatabase db{path, BlobTableDefinition};
+        auto &table = db.GetTable<decltype(BlobTableDefinition)>();
+        std::vector<uint8_t> payload(PayloadSize);
+        std::mt19937 random(42);
+        constexpr int64_t BatchSize = 10000;
+        for (int64_t id = 1; id <= rows;) {
+            db.CreateTransaction([&] {
+                for (int64_t end = std::min(rows, id + BatchSize - 1); id <= end; ++id) {
+                    for (auto &byte: payload) {
+                        byte = static_cast<uint8_t>(random());
+                    }
+                    table.Insert<decltype(IdColumn), decltype(PayloadColumn)>(id, payload);
+                }
+            });
+        }
+    }
+
+    void Run(const std::string &path, int64_t rows, int lookups, int64_t mmapSize) {
+        BlobDatabase db{path, OpenOptions{.mmapSize = mmapSize}, BlobTableDefinition};
+        auto &table = db.GetTable<decltype(BlobTableDefinition)>();
+        std::mt19937_64 random(7);
+        std::uniform_int_distribution<int64_t> ids(1, rows - RangeRows);
+
+        auto pointLookup = [&] {
+            auto id = ids(random);
+            for (const auto &[payload]: table.Select(table[PayloadColumn])
+                 .Where(table[IdColumn] == MakeParamExpr(id)).Results()) {
+                if (payload.size() != PayloadSize) {
+                    throw std::runtime_error("unexpected payload size");
+                }
+            }
+        };
+        auto rangeScan = [&] {
+            auto id = ids(random);
+            int64_t bytes = 0;
+            for (const auto &[payload]: table.Select(table[PayloadColumn])
+                 .Where(table[IdColumn] >= MakeParamExpr(id) && table[IdColumn] < MakeParamExpr(id + RangeRows))
+                 .Results()) {
+                bytes += static_cast<int64_t>(payload.size());
+            }
+            if (bytes != RangeRows * PayloadSize) {
+                throw std::runtime_error("unexpected range size");
+            }
+        };
+
+        // 先跑一輪暖身，讓兩種設定都從相同的 OS page cache 狀態開始
+        MeasureMicroseconds(lookups / 10 + 1, pointLookup);
+        auto pointUs = MeasureMicroseconds(lookups, pointLookup);
+        auto rangeUs = MeasureMicroseconds(lookups / 100 + 1, rangeScan);
+        std::cout << "mmap_size=" << db.GetMmapSize()
+                << "  point lookup: " << pointUs << " us"
+                << "  range scan (" << RangeRows << " rows): " << rangeUs << " us" << std::endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string path = argc > 1 ? argv[1] : "mmap_benchmark.db";
+    int64_t sizeMb = argc > 2 ? std::stoll(argv[2]) : 2048;
+    int lookups = argc > 3 ? std::stoi(argv[3]) : 100000;
+    auto rows = sizeMb * 1024 * 1024 / PayloadSize;
+
+    if (!std::filesystem::exists(path)) {
+        std::cout << "Populating " << path << " with " << rows << " rows..." << std::endl;
+        Populate(path, rows);
+    }
+    auto fileSize = static_cast<int64_t>(std::filesystem::file_size(path));
+    std::cout << "File size: " << fileSize / (1024 * 1024) << " MB" << std::endl;
+
+    Run(path, rows, lookups, 0);
+    Run(path, rows, lookups, fileSize);
+    return 0;
+}
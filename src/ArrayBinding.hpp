@@ -0,0 +1,90 @@
+#pragma once
+#ifdef SQLITE_ENABLE_CARRAY
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "sqlite3.h"
+#include "QueryCache.hpp"
+
+namespace TypeSQLite {
+    // 內建的 carray 表值函式：整個陣列綁定為單一參數，SQL 文字不隨陣列長度改變
+    inline constexpr const char *ArrayFunctionName = "carray";
+
+    template<typename T>
+    constexpr int GetCarrayType() {
+        if constexpr (std::is_same_v<T, int32_t>) {
+            return SQLITE_CARRAY_INT32;
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            return SQLITE_CARRAY_INT64;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return SQLITE_CARRAY_DOUBLE;
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            return SQLITE_CARRAY_TEXT;
+        } else {
+            static_assert([]() { return false; }(), "carray supports int32_t, int64_t, double and text only");
+        }
+    }
+
+    // carray 需要以 '\0' 結尾的 char* 陣列：指標陣列與字串放在同一塊記憶體，由 SQLite 用完後釋放
+    template<typename T>
+    char *MakeCarrayText(std::span<const T> values) {
+        auto size = values.size() * sizeof(char *);
+        for (const auto &value: values) {
+            size += value.size() + 1;
+        }
+        auto pBlock = new char[size];
+        auto pointers = reinterpret_cast<char **>(pBlock);
+        auto pText = pBlock + values.size() * sizeof(char *);
+        for (size_t i = 0; i < values.size(); ++i) {
+            pointers[i] = pText;
+            std::memcpy(pText, values[i].data(), values[i].size());
+            pText += values[i].size();
+            *pText++ = '\0';
+        }
+        return pBlock;
+    }
+
+    // 查詢參數：數值陣列不會被複製，必須存活到查詢結果讀取完畢
+    template<typename T>
+    struct ArrayParam {
+        std::span<const T> values;
+
+        void Bind(sqlite3_stmt *stmt, int index) const {
+            constexpr auto type = GetCarrayType<T>();
+            int rc;
+            if constexpr (type == SQLITE_CARRAY_TEXT) {
+                // 綁定失敗時 SQLite 也會呼叫解構函式
+                rc = sqlite3_carray_bind(stmt, index, MakeCarrayText(values), static_cast<int>(values.size()), type,
+                                         [](void *p) { delete[] static_cast<char *>(p); });
+            } else {
+                rc = sqlite3_carray_bind(stmt, index, const_cast<T *>(values.data()),
+                                         static_cast<int>(values.size()), type, SQLITE_STATIC);
+            }
+            if (rc != SQLITE_OK) {
+                throw std::runtime_error(
+                    "Failed to bind array parameter: " + std::string(sqlite3_errstr(rc)) +
+                    "\nSQL: " + std::string(sqlite3_sql(stmt)));
+            }
+        }
+
+        // 查詢快取以陣列內容作為 key 的一部分
+        void AppendCacheKey(std::string &key) const {
+            key += 'a';
+            key += std::to_string(values.size());
+            key += ':';
+            for (const auto &value: values) {
+                if constexpr (std::is_arithmetic_v<T>) {
+                    TypeSQLite::AppendCacheKey(key, value);
+                } else {
+                    TypeSQLite::AppendCacheKey(key, std::string(value));
+                }
+            }
+        }
+    };
+}
+#endif
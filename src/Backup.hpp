@@ -0,0 +1,61 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "SQLiteWrapper.hpp"
+
+namespace TypeSQLite {
+    struct BackupProgress {
+        int remaining; // 尚未複製的頁數
+        int pageCount; // 來源資料庫總頁數
+    };
+
+    struct BackupOptions {
+        int pagesPerStep = 100; // 每一步複製的頁數，-1 代表一次完成
+        std::chrono::milliseconds sleepBetweenSteps{0}; // 步驟間釋放來源的鎖，讓前景寫入可以進行
+        std::function<bool(const BackupProgress &)> onProgress; // 回傳 false 取消備份
+    };
+
+    // 來源或目的端被鎖住時至少等待的時間，避免 sleepBetweenSteps 為 0 時空轉
+    inline constexpr std::chrono::milliseconds BackupBusyDelay{10};
+
+    // 以 sqlite3_backup 線上備份；完成回傳 true，被取消回傳 false
+    inline bool Backup(sqlite3 *pSource, sqlite3 *pDestination, const BackupOptions &options = {}) {
+        std::unique_ptr<sqlite3_backup, decltype(&sqlite3_backup_finish)> pBackup(
+            sqlite3_backup_init(pDestination, "main", pSource, "main"), sqlite3_backup_finish);
+        if (!pBackup) {
+            throw std::runtime_error("Failed to start backup: " + std::string(sqlite3_errmsg(pDestination)));
+        }
+        while (true) {
+            auto rc = sqlite3_backup_step(pBackup.get(), options.pagesPerStep);
+            if (rc == SQLITE_DONE) {
+                break;
+            }
+            if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+                throw std::runtime_error("Failed to backup database: " + std::string(sqlite3_errstr(rc)));
+            }
+            if (options.onProgress &&
+                !options.onProgress({sqlite3_backup_remaining(pBackup.get()), sqlite3_backup_pagecount(pBackup.get())})) {
+                return false;
+            }
+            if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED) {
+                sqlite3_sleep(static_cast<int>(std::max(options.sleepBetweenSteps, BackupBusyDelay).count()));
+            } else if (options.sleepBetweenSteps.count() > 0) {
+                std::this_thread::sleep_for(options.sleepBetweenSteps);
+            }
+        }
+        if (options.onProgress) {
+            options.onProgress({0, sqlite3_backup_pagecount(pBackup.get())});
+        }
+        auto rc = sqlite3_backup_finish(pBackup.release());
+        if (rc != SQLITE_OK) {
+            throw std::runtime_error("Failed to finish backup: " + std::string(sqlite3_errstr(rc)));
+        }
+        return true;
+    }
+}
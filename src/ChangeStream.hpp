@@ -0,0 +1,338 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "SQLiteWrapper.hpp"
+
+namespace TypeSQLite {
+    enum class ChangeOperation {
+        INSERT,
+        UPDATE,
+        DELETE,
+    };
+
+    inline ChangeOperation ToChangeOperation(int operation) {
+        switch (operation) {
+            case SQLITE_INSERT:
+                return ChangeOperation::INSERT;
+            case SQLITE_DELETE:
+                return ChangeOperation::DELETE;
+            default:
+                return ChangeOperation::UPDATE;
+        }
+    }
+
+    using ChangeValue = std::variant<std::nullptr_t, int64_t, double, std::string, std::vector<uint8_t> >;
+
+    // sqlite3_value 只在 hook 期間有效，必須立即複製
+    inline ChangeValue ToChangeValue(sqlite3_value *pValue) {
+        switch (sqlite3_value_type(pValue)) {
+            case SQLITE_INTEGER:
+                return static_cast<int64_t>(sqlite3_value_int64(pValue));
+            case SQLITE_FLOAT:
+                return sqlite3_value_double(pValue);
+            case SQLITE_TEXT:
+                return std::string(reinterpret_cast<const char *>(sqlite3_value_text(pValue)),
+                                   static_cast<size_t>(sqlite3_value_bytes(pValue)));
+            case SQLITE_BLOB: {
+                auto pBytes = static_cast<const uint8_t *>(sqlite3_value_blob(pValue));
+                return std::vector<uint8_t>(pBytes, pBytes + sqlite3_value_bytes(pValue));
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    // 轉換規則與 GetValue 相同：型別不符時使用預設值或 nullptr
+    template<typename T>
+    T FromChangeValue(const ChangeValue &value) {
+        using ValueT = std::remove_cvref_t<T>;
+        return std::visit([](const auto &v) -> ValueT {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<ValueT, std::string> || std::is_same_v<ValueT, std::vector<uint8_t> >) {
+                if constexpr (std::is_same_v<V, ValueT>) {
+                    return v;
+                } else {
+                    return ValueT{};
+                }
+            } else if constexpr (std::is_floating_point_v<ValueT>) {
+                if constexpr (std::is_arithmetic_v<V>) {
+                    return static_cast<ValueT>(v);
+                } else {
+                    return ValueT{};
+                }
+            } else if constexpr (std::is_integral_v<ValueT>) {
+                if constexpr (std::is_same_v<V, int64_t>) {
+                    return static_cast<ValueT>(v);
+                } else {
+                    return ValueT{};
+                }
+            } else if constexpr (std::is_constructible_v<ValueT, V>) {
+                return ValueT(v);
+            } else {
+                return ValueT{};
+            }
+        }, value);
+    }
+
+    struct ChangeEvent {
+        std::string table;
+        ChangeOperation operation;
+        int64_t rowId;
+        // 只有編譯了 SQLITE_ENABLE_PREUPDATE_HOOK 且 captureValues 時才有值，順序與資料表欄位相同
+        std::vector<ChangeValue> oldValues;
+        std::vector<ChangeValue> newValues;
+    };
+
+    // 同一個交易提交的所有變更
+    struct ChangeBatch {
+        // 每次提交遞增；消費端看到跳號代表 ring buffer 已滿而丟棄了較舊的批次
+        uint64_t sequence;
+        std::vector<ChangeEvent> events;
+    };
+
+    // Table::Subscribe 使用的強型別變更
+    template<typename Row>
+    struct RowChange {
+        ChangeOperation operation;
+        int64_t rowId;
+        std::optional<Row> oldRow;
+        std::optional<Row> newRow;
+    };
+
+    template<typename Row>
+    std::optional<Row> ToRow(const std::vector<ChangeValue> &values) {
+        if (values.size() != std::tuple_size_v<Row>) {
+            return std::nullopt;
+        }
+        return [&values]<size_t... I>(std::index_sequence<I...>) {
+            return Row{FromChangeValue<std::tuple_element_t<I, Row> >(values[I])...};
+        }(std::make_index_sequence<std::tuple_size_v<Row> >{});
+    }
+
+    struct ChangeStreamOptions {
+        size_t capacity = 1024; // ring buffer 可容納的批次數
+        bool captureValues = true;
+        std::vector<std::string> tables; // 空代表所有資料表
+        // 消費端拋出例外時在消費執行緒呼叫，該批次仍視為已處理；回呼本身不可拋出例外
+        std::function<void(std::exception_ptr)> onError;
+    };
+
+    struct ChangeStreamStats {
+        uint64_t committed = 0;
+        uint64_t delivered = 0;
+        uint64_t dropped = 0;
+        uint64_t failed = 0; // 消費端拋出例外的批次數，也計入 delivered
+    };
+
+    // 固定容量的環形緩衝區；滿時覆寫最舊的元素，寫入端不會被消費端阻塞
+    template<typename T>
+    class RingBuffer {
+        std::vector<std::optional<T> > _slots;
+        size_t _head = 0;
+        size_t _size = 0;
+        bool _closed = false;
+        std::mutex _mutex;
+        std::condition_variable _cv;
+
+    public:
+        explicit RingBuffer(size_t capacity) : _slots(capacity == 0 ? 1 : capacity) {
+        }
+
+        // 回傳 false 代表覆寫了尚未取出的元素
+        bool Push(T value) {
+            bool overwritten = false;
+            {
+                std::lock_guard lock(_mutex);
+                auto tail = (_head + _size) % _slots.size();
+                _slots[tail] = std::move(value);
+                if (_size == _slots.size()) {
+                    _head = (_head + 1) % _slots.size();
+                    overwritten = true;
+                } else {
+                    ++_size;
+                }
+            }
+            _cv.notify_one();
+            return !overwritten;
+        }
+
+        // 阻塞直到有元素；關閉且已清空時回傳 nullopt
+        std::optional<T> Pop() {
+            std::unique_lock lock(_mutex);
+            _cv.wait(lock, [this] { return _size > 0 || _closed; });
+            if (_size == 0) {
+                return std::nullopt;
+            }
+            auto value = std::move(_slots[_head]);
+            _slots[_head].reset();
+            _head = (_head + 1) % _slots.size();
+            --_size;
+            return value;
+        }
+
+        void Close() {
+            {
+                std::lock_guard lock(_mutex);
+                _closed = true;
+            }
+            _cv.notify_all();
+        }
+    };
+
+    // 以 update/preupdate hook 收集變更，在 commit hook 時依交易合併成一個批次，
+    // 交給獨立的消費執行緒處理。消費端不應在回呼中使用同一個連線寫入。
+    class ChangeStream {
+    public:
+        using Consumer = std::function<void(const ChangeBatch &)>;
+
+    private:
+        SQLiteWrapper &_sqlite;
+        ChangeStreamOptions _options;
+        Consumer _consumer;
+        // 只在寫入端（hook 回呼）存取
+        std::vector<ChangeEvent> _pending;
+        // 已觸發 commit hook、等待 COMMIT 完成的變更
+        std::vector<ChangeEvent> _committing;
+        std::atomic<uint64_t> _sequence = 0;
+        RingBuffer<ChangeBatch> _buffer;
+        std::atomic<uint64_t> _delivered = 0;
+        std::atomic<uint64_t> _dropped = 0;
+        std::atomic<uint64_t> _failed = 0;
+        std::vector<int> _hookIds;
+        std::thread _worker;
+
+        bool IsWatched(const char *table) const {
+            // 略過 sqlite_sequence 等內部資料表
+            if (std::string_view(table).starts_with("sqlite_")) {
+                return false;
+            }
+            if (_options.tables.empty()) {
+                return true;
+            }
+            for (const auto &name: _options.tables) {
+                if (sqlite3_stricmp(name.c_str(), table) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // COMMIT 失敗時交易仍在進行，之後可能再寫入並重新 COMMIT，因此累加而不是覆蓋
+        void OnCommit() {
+            std::move(_pending.begin(), _pending.end(), std::back_inserter(_committing));
+            _pending.clear();
+        }
+
+        void OnCommitted() {
+            if (_committing.empty()) {
+                return;
+            }
+            if (!_buffer.Push(ChangeBatch{++_sequence, std::move(_committing)})) {
+                ++_dropped;
+            }
+            _committing.clear();
+        }
+
+        void OnRollback() {
+            _pending.clear();
+            _committing.clear();
+        }
+
+        void Run() {
+            while (auto batch = _buffer.Pop()) {
+                try {
+                    _consumer(*batch);
+                } catch (...) {
+                    ++_failed;
+                    if (_options.onError) {
+                        _options.onError(std::current_exception());
+                    }
+                }
+                ++_delivered;
+            }
+        }
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+        void OnPreUpdate(sqlite3 *db, int operation, const char *table, sqlite3_int64 oldRowId,
+                         sqlite3_int64 newRowId) {
+            if (!IsWatched(table)) {
+                return;
+            }
+            ChangeEvent event{
+                table, ToChangeOperation(operation), operation == SQLITE_DELETE ? oldRowId : newRowId, {}, {}
+            };
+            if (_options.captureValues) {
+                auto count = sqlite3_preupdate_count(db);
+                for (int i = 0; i < count; ++i) {
+                    sqlite3_value *pValue = nullptr;
+                    if (operation != SQLITE_INSERT && sqlite3_preupdate_old(db, i, &pValue) == SQLITE_OK) {
+                        event.oldValues.push_back(ToChangeValue(pValue));
+                    }
+                    if (operation != SQLITE_DELETE && sqlite3_preupdate_new(db, i, &pValue) == SQLITE_OK) {
+                        event.newValues.push_back(ToChangeValue(pValue));
+                    }
+                }
+            }
+            _pending.push_back(std::move(event));
+        }
+#endif
+
+    public:
+        ChangeStream(SQLiteWrapper &sqlite, Consumer consumer, ChangeStreamOptions options = {})
+            : _sqlite(sqlite), _options(std::move(options)), _consumer(std::move(consumer)),
+              _buffer(_options.capacity) {
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            // preupdate hook 也會涵蓋 WITHOUT ROWID 資料表
+            _hookIds.push_back(_sqlite.AddPreUpdateHook(
+                [this](sqlite3 *db, int operation, const char *, const char *table, sqlite3_int64 oldRowId,
+                       sqlite3_int64 newRowId) {
+                    OnPreUpdate(db, operation, table, oldRowId, newRowId);
+                }));
+#else
+            _hookIds.push_back(_sqlite.AddUpdateHook(
+                [this](int operation, const char *, const char *table, sqlite3_int64 rowId) {
+                    if (IsWatched(table)) {
+                        _pending.push_back(ChangeEvent{table, ToChangeOperation(operation), rowId, {}, {}});
+                    }
+                }));
+#endif
+            // 只在交易確實寫入後才送出批次，避免消費端收到最後失敗的 COMMIT
+            _hookIds.push_back(_sqlite.AddCommitHook([this] { OnCommit(); }));
+            _hookIds.push_back(_sqlite.AddCommittedHook([this] { OnCommitted(); }));
+            _hookIds.push_back(_sqlite.AddRollbackHook([this] { OnRollback(); }));
+            _worker = std::thread([this] { Run(); });
+        }
+
+        ChangeStream(const ChangeStream &) = delete;
+
+        ChangeStream &operator=(const ChangeStream &) = delete;
+
+        // 停止收集並等待消費端處理完已提交的批次
+        ~ChangeStream() {
+            for (auto id: _hookIds) {
+                _sqlite.RemoveHook(id);
+            }
+            _buffer.Close();
+            _worker.join();
+        }
+
+        ChangeStreamStats Stats() const {
+            return ChangeStreamStats{_sequence, _delivered, _dropped, _failed};
+        }
+    };
+}
@@ -0,0 +1,443 @@
+#pragma once
+#ifdef SQLITE_ENABLE_SESSION
+// 記錄變更需要 preupdate hook，套用與反轉變更集使用 session 擴充
+#ifndef SQLITE_ENABLE_PREUPDATE_HOOK
+#error "SQLITE_ENABLE_SESSION requires SQLITE_ENABLE_PREUPDATE_HOOK"
+#endif
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "SQLiteWrapper.hpp"
+#include "ChangeStream.hpp"
+#include "TemplateHelper/FixedString.hpp"
+#include "SQLiteStruct/Column/ConflictCause.hpp"
+
+namespace TypeSQLite {
+    // 與 sqlite3session_changeset 相同格式的二進位變更集
+    using Changeset = std::vector<uint8_t>;
+
+    // SQLite 的 varint：大端序，每個位元組 7 位元，第 9 個位元組使用完整 8 位元
+    inline void AppendChangesetVarint(Changeset &buffer, uint64_t value) {
+        if (value & (uint64_t{0xff000000} << 32)) {
+            uint8_t bytes[9];
+            bytes[8] = static_cast<uint8_t>(value);
+            value >>= 8;
+            for (int i = 7; i >= 0; --i) {
+                bytes[i] = static_cast<uint8_t>((value & 0x7f) | 0x80);
+                value >>= 7;
+            }
+            buffer.insert(buffer.end(), bytes, bytes + 9);
+            return;
+        }
+        uint8_t bytes[9];
+        int count = 0;
+        do {
+            bytes[count++] = static_cast<uint8_t>((value & 0x7f) | 0x80);
+            value >>= 7;
+        } while (value != 0);
+        bytes[0] &= 0x7f;
+        for (int i = count - 1; i >= 0; --i) {
+            buffer.push_back(bytes[i]);
+        }
+    }
+
+    inline void AppendChangesetValue(Changeset &buffer, const ChangeValue &value) {
+        auto appendUInt64 = [&buffer](uint64_t bits) {
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                buffer.push_back(static_cast<uint8_t>(bits >> shift));
+            }
+        };
+        std::visit([&]<typename V>(const V &v) {
+            if constexpr (std::is_same_v<V, int64_t>) {
+                buffer.push_back(SQLITE_INTEGER);
+                appendUInt64(static_cast<uint64_t>(v));
+            } else if constexpr (std::is_same_v<V, double>) {
+                buffer.push_back(SQLITE_FLOAT);
+                appendUInt64(std::bit_cast<uint64_t>(v));
+            } else if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::vector<uint8_t> >) {
+                buffer.push_back(std::is_same_v<V, std::string> ? SQLITE_TEXT : SQLITE_BLOB);
+                AppendChangesetVarint(buffer, v.size());
+                buffer.insert(buffer.end(), v.begin(), v.end());
+            } else {
+                buffer.push_back(SQLITE_NULL);
+            }
+        }, value);
+    }
+
+    inline void BindChangeValue(sqlite3_stmt *stmt, int index, const ChangeValue &value) {
+        std::visit([&]<typename V>(const V &v) {
+            if constexpr (std::is_same_v<V, int64_t>) {
+                sqlite3_bind_int64(stmt, index, v);
+            } else if constexpr (std::is_same_v<V, double>) {
+                sqlite3_bind_double(stmt, index, v);
+            } else if constexpr (std::is_same_v<V, std::string>) {
+                sqlite3_bind_text(stmt, index, v.data(), static_cast<int>(v.size()), SQLITE_TRANSIENT);
+            } else if constexpr (std::is_same_v<V, std::vector<uint8_t> >) {
+                sqlite3_bind_blob(stmt, index, v.data(), static_cast<int>(v.size()), SQLITE_TRANSIENT);
+            } else {
+                sqlite3_bind_null(stmt, index);
+            }
+        }, value);
+    }
+
+    inline std::string QuoteChangesetIdentifier(std::string_view name) {
+        std::string quoted = "\"";
+        for (auto c: name) {
+            quoted += c;
+            if (c == '"') {
+                quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+
+    // RAII：記錄指定資料表的變更，產生與 session 擴充相同格式的變更集。
+    // sqlite3session 會獨佔連線的 preupdate hook，且無法與其他回呼串接，
+    // 因此改為訂閱 SQLiteWrapper 分派的 preupdate hook，才能與 ChangeStream 同時使用。
+    // 與 session 相同：只記錄建立時已存在且有 PRIMARY KEY 的資料表，主鍵含 NULL 的列會被略過；
+    // 每列只保留第一次變更前的值，產生變更集時再與目前的資料比對。
+    class ChangeRecorder {
+        struct RowState {
+            bool existedBefore;
+            bool indirect;
+            std::vector<ChangeValue> oldValues;
+        };
+
+        // std::nullptr_t 沒有順序比較，主鍵也不會包含 NULL
+        struct KeyLess {
+            bool operator()(const std::vector<ChangeValue> &lhs, const std::vector<ChangeValue> &rhs) const {
+                return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                                    [](const ChangeValue &a, const ChangeValue &b) {
+                                                        if (a.index() != b.index()) {
+                                                            return a.index() < b.index();
+                                                        }
+                                                        return std::visit([&b]<typename V>(const V &value) {
+                                                            if constexpr (std::is_same_v<V, std::nullptr_t>) {
+                                                                return false;
+                                                            } else {
+                                                                return value < std::get<V>(b);
+                                                            }
+                                                        }, a);
+                                                    });
+            }
+        };
+
+        struct TableChanges {
+            std::string name;
+            std::vector<std::string> columns;
+            // 每個欄位在主鍵中的位置（從 1 開始），0 代表不是主鍵；直接寫入變更集的表頭
+            std::vector<uint8_t> primaryKey;
+            std::map<std::vector<ChangeValue>, RowState, KeyLess> rows;
+        };
+
+        SQLiteWrapper &_sqlite;
+        std::vector<TableChanges> _tables;
+        bool _schemaChanged = false;
+        int _hookId = -1;
+
+        void LoadTable(const std::string &table) {
+            sqlite3_stmt *pStmt = nullptr;
+            if (sqlite3_prepare_v2(_sqlite._dbPtr.get(), "SELECT name, pk FROM pragma_table_info(?, 'main');", -1,
+                                   &pStmt, nullptr) != SQLITE_OK) {
+                throw std::runtime_error(
+                    "Failed to read table schema: " + std::string(sqlite3_errmsg(_sqlite._dbPtr.get())));
+            }
+            auto pAutoStmt = MakeAutoStmtPtr(pStmt);
+            sqlite3_bind_text(pStmt, 1, table.c_str(), -1, SQLITE_TRANSIENT);
+            TableChanges changes{table, {}, {}, {}};
+            bool hasPrimaryKey = false;
+            while (sqlite3_step(pStmt) == SQLITE_ROW) {
+                changes.columns.emplace_back(reinterpret_cast<const char *>(sqlite3_column_text(pStmt, 0)));
+                changes.primaryKey.push_back(static_cast<uint8_t>(sqlite3_column_int(pStmt, 1)));
+                hasPrimaryKey = hasPrimaryKey || changes.primaryKey.back() != 0;
+            }
+            if (hasPrimaryKey) {
+                _tables.push_back(std::move(changes));
+            }
+        }
+
+        TableChanges *FindTable(const char *table) {
+            for (auto &changes: _tables) {
+                if (sqlite3_stricmp(changes.name.c_str(), table) == 0) {
+                    return &changes;
+                }
+            }
+            return nullptr;
+        }
+
+        static std::vector<ChangeValue> ReadValues(sqlite3 *db, int count, bool isNew) {
+            std::vector<ChangeValue> values;
+            values.reserve(static_cast<size_t>(count));
+            for (int i = 0; i < count; ++i) {
+                sqlite3_value *pValue = nullptr;
+                if ((isNew ? sqlite3_preupdate_new(db, i, &pValue) : sqlite3_preupdate_old(db, i, &pValue)) !=
+                    SQLITE_OK) {
+                    pValue = nullptr;
+                }
+                values.push_back(pValue ? ToChangeValue(pValue) : ChangeValue{nullptr});
+            }
+            return values;
+        }
+
+        static std::vector<ChangeValue> GetKey(const TableChanges &changes, const std::vector<ChangeValue> &values) {
+            std::vector<ChangeValue> key;
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (changes.primaryKey[i] != 0) {
+                    key.push_back(values[i]);
+                }
+            }
+            return key;
+        }
+
+        // 同一列只保留第一次的狀態；所有變更都由 trigger 或外鍵動作造成時才標記為間接變更
+        static void Record(TableChanges &changes, std::vector<ChangeValue> key, bool existedBefore, bool indirect,
+                           std::vector<ChangeValue> oldValues) {
+            for (const auto &value: key) {
+                if (std::holds_alternative<std::nullptr_t>(value)) {
+                    return;
+                }
+            }
+            auto [it, inserted] = changes.rows.try_emplace(std::move(key),
+                                                           RowState{existedBefore, indirect, std::move(oldValues)});
+            if (!inserted) {
+                it->second.indirect = it->second.indirect && indirect;
+            }
+        }
+
+        void OnPreUpdate(sqlite3 *db, int operation, const char *database, const char *table) {
+            if (sqlite3_stricmp(database, "main") != 0) {
+                return;
+            }
+            auto *pChanges = FindTable(table);
+            if (!pChanges) {
+                return;
+            }
+            auto count = sqlite3_preupdate_count(db);
+            if (static_cast<size_t>(count) != pChanges->columns.size()) {
+                _schemaChanged = true;
+                return;
+            }
+            auto indirect = sqlite3_preupdate_depth(db) > 0;
+            if (operation == SQLITE_INSERT) {
+                Record(*pChanges, GetKey(*pChanges, ReadValues(db, count, true)), false, indirect, {});
+                return;
+            }
+            auto oldValues = ReadValues(db, count, false);
+            auto oldKey = GetKey(*pChanges, oldValues);
+            if (operation == SQLITE_UPDATE) {
+                // 修改主鍵相當於刪除舊列並新增一列
+                auto newKey = GetKey(*pChanges, ReadValues(db, count, true));
+                if (newKey != oldKey) {
+                    Record(*pChanges, std::move(newKey), false, indirect, {});
+                }
+            }
+            Record(*pChanges, std::move(oldKey), true, indirect, std::move(oldValues));
+        }
+
+        // 讀取目前的資料並與記錄的舊值比對：列不存在時為 DELETE，之前不存在時為 INSERT，
+        // 否則只寫入有變動的欄位；最終沒有差異的列不會出現在變更集中
+        Changeset Generate(bool isPatchset) const {
+            if (_schemaChanged) {
+                throw std::runtime_error("Failed to generate changeset: table schema changed while recording");
+            }
+            auto *db = _sqlite._dbPtr.get();
+            Changeset buffer;
+            for (const auto &changes: _tables) {
+                if (changes.rows.empty()) {
+                    continue;
+                }
+                std::string sql = "SELECT ";
+                std::string where;
+                for (size_t i = 0; i < changes.columns.size(); ++i) {
+                    auto column = QuoteChangesetIdentifier(changes.columns[i]);
+                    sql += (i == 0 ? "" : ", ") + column;
+                    if (changes.primaryKey[i] != 0) {
+                        where += (where.empty() ? "" : " AND ") + column + " = ?";
+                    }
+                }
+                sql += " FROM main." + QuoteChangesetIdentifier(changes.name) + " WHERE " + where + ";";
+                sqlite3_stmt *pStmt = nullptr;
+                if (sqlite3_prepare_v2(db, sql.c_str(), -1, &pStmt, nullptr) != SQLITE_OK) {
+                    throw std::runtime_error("Failed to generate changeset: " + std::string(sqlite3_errmsg(db)) +
+                                             "\nSQL: " + sql);
+                }
+                auto pAutoStmt = MakeAutoStmtPtr(pStmt);
+                auto columnCount = changes.columns.size();
+                bool hasHeader = false;
+                for (const auto &[key, row]: changes.rows) {
+                    sqlite3_reset(pStmt);
+                    for (size_t i = 0; i < key.size(); ++i) {
+                        BindChangeValue(pStmt, static_cast<int>(i + 1), key[i]);
+                    }
+                    auto rc = sqlite3_step(pStmt);
+                    if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+                        throw std::runtime_error("Failed to generate changeset: " + std::string(sqlite3_errmsg(db)));
+                    }
+                    std::vector<ChangeValue> current;
+                    if (rc == SQLITE_ROW) {
+                        for (size_t i = 0; i < columnCount; ++i) {
+                            current.push_back(ToChangeValue(sqlite3_column_value(pStmt, static_cast<int>(i))));
+                        }
+                    }
+                    if (current.empty() && !row.existedBefore) {
+                        continue;
+                    }
+                    std::vector<bool> changed(columnCount, false);
+                    if (!current.empty() && row.existedBefore) {
+                        bool isNoop = true;
+                        for (size_t i = 0; i < columnCount; ++i) {
+                            changed[i] = current[i] != row.oldValues[i];
+                            isNoop = isNoop && !changed[i];
+                        }
+                        if (isNoop) {
+                            continue;
+                        }
+                    }
+                    if (!hasHeader) {
+                        hasHeader = true;
+                        buffer.push_back(isPatchset ? 'P' : 'T');
+                        AppendChangesetVarint(buffer, columnCount);
+                        buffer.insert(buffer.end(), changes.primaryKey.begin(), changes.primaryKey.end());
+                        buffer.insert(buffer.end(), changes.name.begin(), changes.name.end());
+                        buffer.push_back(0);
+                    }
+                    if (!row.existedBefore) {
+                        buffer.push_back(SQLITE_INSERT);
+                        buffer.push_back(row.indirect);
+                        for (const auto &value: current) {
+                            AppendChangesetValue(buffer, value);
+                        }
+                    } else if (current.empty()) {
+                        // patchset 的 DELETE 只包含主鍵
+                        buffer.push_back(SQLITE_DELETE);
+                        buffer.push_back(row.indirect);
+                        for (size_t i = 0; i < columnCount; ++i) {
+                            if (!isPatchset || changes.primaryKey[i] != 0) {
+                                AppendChangesetValue(buffer, row.oldValues[i]);
+                            }
+                        }
+                    } else {
+                        // 未變動的欄位寫入 0 代表未定義；patchset 沒有舊值，新值包含主鍵
+                        buffer.push_back(SQLITE_UPDATE);
+                        buffer.push_back(row.indirect);
+                        if (!isPatchset) {
+                            for (size_t i = 0; i < columnCount; ++i) {
+                                if (changed[i] || changes.primaryKey[i] != 0) {
+                                    AppendChangesetValue(buffer, row.oldValues[i]);
+                                } else {
+                                    buffer.push_back(0);
+                                }
+                            }
+                        }
+                        for (size_t i = 0; i < columnCount; ++i) {
+                            if (changed[i] || (isPatchset && changes.primaryKey[i] != 0)) {
+                                AppendChangesetValue(buffer, current[i]);
+                            } else {
+                                buffer.push_back(0);
+                            }
+                        }
+                    }
+                }
+            }
+            return buffer;
+        }
+
+    public:
+        ChangeRecorder(SQLiteWrapper &sqlite, const std::vector<std::string> &tables) : _sqlite(sqlite) {
+            for (const auto &table: tables) {
+                LoadTable(table);
+            }
+            _hookId = _sqlite.AddPreUpdateHook(
+                [this](sqlite3 *db, int operation, const char *database, const char *table, sqlite3_int64,
+                       sqlite3_int64) {
+                    OnPreUpdate(db, operation, database, table);
+                });
+        }
+
+        ChangeRecorder(const ChangeRecorder &) = delete;
+
+        ChangeRecorder &operator=(const ChangeRecorder &) = delete;
+
+        ~ChangeRecorder() {
+            _sqlite.RemoveHook(_hookId);
+        }
+
+        // 包含 UPDATE/DELETE 的舊值，可用於衝突偵測與反轉
+        Changeset GetChangeset() const {
+            return Generate(false);
+        }
+
+        // 只包含主鍵與新值，體積較小但無法偵測 DATA 衝突
+        Changeset GetPatchset() const {
+            return Generate(true);
+        }
+
+        // 與 sqlite3session_isempty 相同：只要有記錄到變更就不是空的，即使最後的資料與開始時相同
+        bool IsEmpty() const {
+            for (const auto &changes: _tables) {
+                if (!changes.rows.empty()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    inline Changeset InvertChangeset(const Changeset &changeset) {
+        int size = 0;
+        void *pBuffer = nullptr;
+        auto rc = sqlite3changeset_invert(static_cast<int>(changeset.size()), const_cast<uint8_t *>(changeset.data()),
+                                          &size, &pBuffer);
+        std::unique_ptr<void, decltype(&sqlite3_free)> buffer(pBuffer, sqlite3_free);
+        if (rc != SQLITE_OK) {
+            throw std::runtime_error("Failed to invert changeset");
+        }
+        auto pBytes = static_cast<const uint8_t *>(buffer.get());
+        return pBytes ? Changeset(pBytes, pBytes + size) : Changeset{};
+    }
+
+    // 將 ConflictCause 對應到 sqlite3changeset_apply 的衝突處理：
+    // IGNORE 略過衝突的變更；REPLACE 以變更集的資料覆寫，目標列不存在時略過；
+    // 其餘中止並還原整個變更集（apply 本身是原子的，ROLLBACK/ABORT/FAIL 行為相同）
+    inline int ResolveChangesetConflict(ConflictCause policy, int conflictType) {
+        switch (policy) {
+            case ConflictCause::IGNORE:
+                return SQLITE_CHANGESET_OMIT;
+            case ConflictCause::REPLACE:
+                if (conflictType == SQLITE_CHANGESET_DATA || conflictType == SQLITE_CHANGESET_CONFLICT) {
+                    return SQLITE_CHANGESET_REPLACE;
+                }
+                if (conflictType == SQLITE_CHANGESET_NOTFOUND) {
+                    return SQLITE_CHANGESET_OMIT;
+                }
+                return SQLITE_CHANGESET_ABORT;
+            default:
+                return SQLITE_CHANGESET_ABORT;
+        }
+    }
+
+    inline void ApplyChangeset(SQLiteWrapper &sqlite, const Changeset &changeset,
+                               ConflictCause policy = ConflictCause::ABORT) {
+        auto rc = sqlite3changeset_apply(sqlite._dbPtr.get(), static_cast<int>(changeset.size()),
+                                         const_cast<uint8_t *>(changeset.data()), nullptr,
+                                         [](void *pPolicy, int conflictType, sqlite3_changeset_iter *) {
+                                             return ResolveChangesetConflict(*static_cast<ConflictCause *>(pPolicy),
+                                                                             conflictType);
+                                         }, &policy);
+        // autocommit 下 apply 會自行提交
+        sqlite.NotifyCommitted();
+        if (rc != SQLITE_OK) {
+            throw std::runtime_error(
+                "Failed to apply changeset: " + std::string(sqlite3_errstr(rc)));
+        }
+    }
+}
+#endif
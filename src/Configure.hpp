@@ -0,0 +1,248 @@
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "SQLiteWrapper.hpp"
+
+namespace TypeSQLite {
+    // 可透過 SQLITE_CONFIG_MALLOC 交給 SQLite 使用的配置器，必須是執行緒安全的
+    template<typename T>
+    concept SQLiteAllocatorConcept = requires(T &allocator, void *p, int n) {
+        { allocator.Allocate(n) } -> std::same_as<void *>;
+        { allocator.Reallocate(p, n) } -> std::same_as<void *>;
+        allocator.Free(p);
+        { allocator.Size(p) } -> std::same_as<int>;
+        { allocator.RoundUp(n) } -> std::same_as<int>;
+    };
+
+    // 依大小分級的執行緒快取配置器：小區塊釋放後留在目前執行緒的 free list 重複使用，避免多執行緒競爭 malloc 的鎖
+    class ThreadCachingAllocator {
+        static constexpr int MinClassSize = 16;
+        static constexpr int ClassCount = 9; // 16 ~ 4096 bytes
+        static constexpr int MaxCachedPerClass = 256;
+        // 保持 16 bytes 對齊，並記錄區塊大小供 xSize 使用
+        static constexpr size_t HeaderSize = 16;
+
+        struct Header {
+            int size;
+            int sizeClass; // -1 代表直接使用 malloc 的大區塊
+        };
+
+        struct FreeList {
+            void *head = nullptr;
+            int count = 0;
+        };
+
+        struct Cache {
+            std::array<FreeList, ClassCount> lists;
+
+            ~Cache() {
+                for (auto &list: lists) {
+                    while (list.head) {
+                        auto next = *static_cast<void **>(list.head);
+                        std::free(static_cast<uint8_t *>(list.head) - HeaderSize);
+                        list.head = next;
+                    }
+                }
+                Destroyed() = true;
+            }
+        };
+
+        // 執行緒結束後仍可能有釋放發生，此時直接交還給 free
+        static bool &Destroyed() {
+            thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        static Cache *LocalCache() {
+            if (Destroyed()) {
+                return nullptr;
+            }
+            thread_local Cache cache;
+            return &cache;
+        }
+
+        static int SizeClass(int size) {
+            int sizeClass = 0;
+            for (int classSize = MinClassSize; classSize < size; classSize <<= 1) {
+                ++sizeClass;
+            }
+            return sizeClass < ClassCount ? sizeClass : -1;
+        }
+
+        static Header *GetHeader(void *p) {
+            return reinterpret_cast<Header *>(static_cast<uint8_t *>(p) - HeaderSize);
+        }
+
+    public:
+        void *Allocate(int size) {
+            auto rounded = RoundUp(size);
+            auto sizeClass = SizeClass(rounded);
+            if (sizeClass >= 0) {
+                if (auto *pCache = LocalCache(); pCache && pCache->lists[sizeClass].head) {
+                    auto &list = pCache->lists[sizeClass];
+                    auto p = list.head;
+                    list.head = *static_cast<void **>(p);
+                    --list.count;
+                    return p;
+                }
+            }
+            auto pBlock = static_cast<uint8_t *>(std::malloc(HeaderSize + rounded));
+            if (!pBlock) {
+                return nullptr;
+            }
+            *reinterpret_cast<Header *>(pBlock) = Header{rounded, sizeClass};
+            return pBlock + HeaderSize;
+        }
+
+        void Free(void *p) {
+            if (!p) {
+                return;
+            }
+            auto header = GetHeader(p);
+            if (header->sizeClass >= 0) {
+                if (auto *pCache = LocalCache(); pCache && pCache->lists[header->sizeClass].count < MaxCachedPerClass) {
+                    auto &list = pCache->lists[header->sizeClass];
+                    *static_cast<void **>(p) = list.head;
+                    list.head = p;
+                    ++list.count;
+                    return;
+                }
+            }
+            std::free(header);
+        }
+
+        void *Reallocate(void *p, int size) {
+            if (!p) {
+                return Allocate(size);
+            }
+            auto oldSize = Size(p);
+            if (RoundUp(size) == oldSize) {
+                return p;
+            }
+            auto pNew = Allocate(size);
+            if (pNew) {
+                std::memcpy(pNew, p, static_cast<size_t>(std::min(oldSize, size)));
+                Free(p);
+            }
+            return pNew;
+        }
+
+        int Size(void *p) {
+            return p ? GetHeader(p)->size : 0;
+        }
+
+        // 小區塊取整到所屬分級，讓 SQLite 能使用整個區塊
+        int RoundUp(int size) {
+            if (size <= MinClassSize << (ClassCount - 1)) {
+                int classSize = MinClassSize;
+                while (classSize < size) {
+                    classSize <<= 1;
+                }
+                return classSize;
+            }
+            return (size + 7) & ~7;
+        }
+    };
+
+    // 將配置器轉接成 sqlite3_mem_methods；SQLite 的回呼沒有 user data，因此每個型別只能有一個實例
+    template<SQLiteAllocatorConcept Allocator>
+    struct MemMethodsAdapter {
+        static inline Allocator *pAllocator = nullptr;
+
+        static void *Malloc(int size) {
+            return pAllocator->Allocate(size);
+        }
+
+        static void Free(void *p) {
+            pAllocator->Free(p);
+        }
+
+        static void *Realloc(void *p, int size) {
+            return pAllocator->Reallocate(p, size);
+        }
+
+        static int Size(void *p) {
+            return pAllocator->Size(p);
+        }
+
+        static int RoundUp(int size) {
+            return pAllocator->RoundUp(size);
+        }
+
+        static int Init(void *) {
+            return SQLITE_OK;
+        }
+
+        static void Shutdown(void *) {
+        }
+    };
+
+    // allocator 必須存活到 SQLite 不再使用它（下一次 Configure 或程式結束）
+    template<SQLiteAllocatorConcept Allocator>
+    sqlite3_mem_methods UseAllocator(Allocator &allocator) {
+        using Adapter = MemMethodsAdapter<Allocator>;
+        Adapter::pAllocator = &allocator;
+        return sqlite3_mem_methods{
+            Adapter::Malloc, Adapter::Free, Adapter::Realloc, Adapter::Size, Adapter::RoundUp, Adapter::Init,
+            Adapter::Shutdown, nullptr
+        };
+    }
+
+    struct PageCacheConfig {
+        int pageSize = 4096; // 資料庫的最大 page size
+        int slots = 0;
+    };
+
+    struct EngineConfig {
+        std::optional<sqlite3_mem_methods> memMethods; // 未指定時恢復編譯時的預設配置器
+        std::optional<PageCacheConfig> pageCache; // 預先配置的 page cache 緩衝區，用完時才退回一般配置；未指定時不使用
+        // 新連線的 lookaside 預設大小。SQLite 無法查詢編譯時的 SQLITE_DEFAULT_LOOKASIDE，未指定時維持目前的設定
+        std::optional<LookasideConfig> lookaside;
+    };
+
+    inline void CheckConfig(int rc, const std::string &option) {
+        if (rc != SQLITE_OK) {
+            throw std::runtime_error("Failed to configure " + option + ": " + std::string(sqlite3_errstr(rc)));
+        }
+    }
+
+    // 行程層級的 sqlite3_config 設定。會先 sqlite3_shutdown，呼叫前必須關閉所有連線
+    inline void Configure(const EngineConfig &config) {
+        static std::unique_ptr<uint8_t[]> pageCacheBuffer;
+
+        CheckConfig(sqlite3_shutdown(), "shutdown");
+        // xMalloc 為空時 sqlite3_initialize 會重新套用編譯時的預設配置器
+        const sqlite3_mem_methods defaultMemMethods{};
+        CheckConfig(sqlite3_config(SQLITE_CONFIG_MALLOC, config.memMethods ? &*config.memMethods : &defaultMemMethods),
+                    "SQLITE_CONFIG_MALLOC");
+
+        std::unique_ptr<uint8_t[]> buffer;
+        if (config.pageCache && config.pageCache->slots > 0) {
+            int headerSize = 0;
+            CheckConfig(sqlite3_config(SQLITE_CONFIG_PCACHE_HDRSZ, &headerSize), "SQLITE_CONFIG_PCACHE_HDRSZ");
+            auto slotSize = config.pageCache->pageSize + headerSize;
+            buffer = std::make_unique<uint8_t[]>(static_cast<size_t>(slotSize) * config.pageCache->slots);
+            CheckConfig(sqlite3_config(SQLITE_CONFIG_PAGECACHE, buffer.get(), slotSize, config.pageCache->slots),
+                        "SQLITE_CONFIG_PAGECACHE");
+        } else {
+            CheckConfig(sqlite3_config(SQLITE_CONFIG_PAGECACHE, nullptr, 0, 0), "SQLITE_CONFIG_PAGECACHE");
+        }
+        // SQLite 已在 shutdown 後不再使用舊的緩衝區
+        pageCacheBuffer = std::move(buffer);
+
+        if (config.lookaside) {
+            CheckConfig(sqlite3_config(SQLITE_CONFIG_LOOKASIDE, config.lookaside->slotSize, config.lookaside->slots),
+                        "SQLITE_CONFIG_LOOKASIDE");
+        }
+
+        CheckConfig(sqlite3_initialize(), "initialize");
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "SQLiteWrapper.hpp"
+
+namespace TypeSQLite {
+    struct StatusValue {
+        int64_t current = 0;
+        int64_t highwater = 0;
+    };
+
+    // sqlite3_status64，整個行程共用（需啟用 SQLITE_CONFIG_MEMSTATUS，預設開啟）
+    struct GlobalMemoryStats {
+        StatusValue memoryUsed; // 目前配置的位元組數
+        StatusValue mallocCount; // 未釋放的配置次數
+        StatusValue mallocSize; // 只有 highwater 有意義：最大的單次配置
+        StatusValue pageCacheUsed; // SQLITE_CONFIG_PAGECACHE 使用中的格數
+        StatusValue pageCacheOverflow; // page cache 放不下而改用一般配置的位元組數
+        StatusValue pageCacheSize; // 只有 highwater 有意義：最大的 page cache 配置
+    };
+
+    // sqlite3_db_status，單一連線
+    struct ConnectionMemoryStats {
+        StatusValue cacheUsed; // page cache 的位元組數
+        StatusValue cacheHit; // 以下四項只有 current 有意義，為累計次數
+        StatusValue cacheMiss;
+        StatusValue cacheWrite;
+        StatusValue cacheSpill;
+        StatusValue schemaUsed; // schema 佔用的位元組數
+        StatusValue stmtUsed; // prepared statement 佔用的位元組數
+        StatusValue lookasideUsed; // 使用中的 lookaside 格數
+        StatusValue lookasideHit; // 以下三項只有 highwater 有意義
+        StatusValue lookasideMissSize;
+        StatusValue lookasideMissFull;
+    };
+
+    struct MemoryStatsSnapshot {
+        GlobalMemoryStats global;
+        ConnectionMemoryStats connection;
+    };
+
+    inline StatusValue GetStatus(int op, bool resetHighwater) {
+        sqlite3_int64 current = 0;
+        sqlite3_int64 highwater = 0;
+        if (sqlite3_status64(op, &current, &highwater, resetHighwater) != SQLITE_OK) {
+            throw std::runtime_error("Failed to read sqlite3_status64: " + std::to_string(op));
+        }
+        return {current, highwater};
+    }
+
+    inline StatusValue GetDbStatus(sqlite3 *db, int op, bool reset) {
+        int current = 0;
+        int highwater = 0;
+        if (sqlite3_db_status(db, op, &current, &highwater, reset) != SQLITE_OK) {
+            throw std::runtime_error("Failed to read sqlite3_db_status: " + std::to_string(op));
+        }
+        return {current, highwater};
+    }
+
+    // reset 時將 highwater 與累計計數歸零，方便計算兩次取樣之間的變化
+    inline GlobalMemoryStats GetGlobalMemoryStats(bool reset = false) {
+        return GlobalMemoryStats{
+            .memoryUsed = GetStatus(SQLITE_STATUS_MEMORY_USED, reset),
+            .mallocCount = GetStatus(SQLITE_STATUS_MALLOC_COUNT, reset),
+            .mallocSize = GetStatus(SQLITE_STATUS_MALLOC_SIZE, reset),
+            .pageCacheUsed = GetStatus(SQLITE_STATUS_PAGECACHE_USED, reset),
+            .pageCacheOverflow = GetStatus(SQLITE_STATUS_PAGECACHE_OVERFLOW, reset),
+            .pageCacheSize = GetStatus(SQLITE_STATUS_PAGECACHE_SIZE, reset),
+        };
+    }
+
+    // sqlite3_db_status 讀取連線內部的狀態，必須在使用該連線的執行緒呼叫
+    inline MemoryStatsSnapshot GetMemoryStats(sqlite3 *db, bool reset = false) {
+        return MemoryStatsSnapshot{
+            .global = GetGlobalMemoryStats(reset),
+            .connection = {
+                .cacheUsed = GetDbStatus(db, SQLITE_DBSTATUS_CACHE_USED, reset),
+                .cacheHit = GetDbStatus(db, SQLITE_DBSTATUS_CACHE_HIT, reset),
+                .cacheMiss = GetDbStatus(db, SQLITE_DBSTATUS_CACHE_MISS, reset),
+                .cacheWrite = GetDbStatus(db, SQLITE_DBSTATUS_CACHE_WRITE, reset),
+                .cacheSpill = GetDbStatus(db, SQLITE_DBSTATUS_CACHE_SPILL, reset),
+                .schemaUsed = GetDbStatus(db, SQLITE_DBSTATUS_SCHEMA_USED, reset),
+                .stmtUsed = GetDbStatus(db, SQLITE_DBSTATUS_STMT_USED, reset),
+                .lookasideUsed = GetDbStatus(db, SQLITE_DBSTATUS_LOOKASIDE_USED, reset),
+                .lookasideHit = GetDbStatus(db, SQLITE_DBSTATUS_LOOKASIDE_HIT, reset),
+                .lookasideMissSize = GetDbStatus(db, SQLITE_DBSTATUS_LOOKASIDE_MISS_SIZE, reset),
+                .lookasideMissFull = GetDbStatus(db, SQLITE_DBSTATUS_LOOKASIDE_MISS_FULL, reset),
+            }
+        };
+    }
+
+    // 在背景執行緒定期取樣並呼叫 callback，解構時停止。
+    // 只讀取 sqlite3_status64 的行程計數器（由 SQLite 的全域互斥鎖保護）；
+    // SQLITE_THREADSAFE=2 時連線沒有互斥鎖，連線的數值請在擁有連線的執行緒以 GetMemoryStats 讀取
+    class MemoryStatsSampler {
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        bool _stopped = false;
+        std::thread _worker;
+
+    public:
+        using Callback = std::function<void(const GlobalMemoryStats &)>;
+
+        MemoryStatsSampler(std::chrono::milliseconds interval, Callback callback) {
+            _worker = std::thread([this, interval, callback = std::move(callback)] {
+                std::unique_lock lock(_mutex);
+                while (!_cv.wait_for(lock, interval, [this] { return _stopped; })) {
+                    try {
+                        callback(GetGlobalMemoryStats());
+                    } catch (const std::exception &exception) {
+                        std::cerr << exception.what() << std::endl;
+                    }
+                }
+            });
+        }
+
+        MemoryStatsSampler(const MemoryStatsSampler &) = delete;
+
+        MemoryStatsSampler &operator=(const MemoryStatsSampler &) = delete;
+
+        ~MemoryStatsSampler() {
+            {
+                std::lock_guard lock(_mutex);
+                _stopped = true;
+            }
+            _cv.notify_all();
+            _worker.join();
+        }
+    };
+}
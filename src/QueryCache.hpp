@@ -0,0 +1,206 @@
+#pragma once
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TypeSQLite {
+    struct QueryCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t maxBytes = 0;
+    };
+
+    // 只估算動態配置的部分，固定大小由 sizeof(tuple) 計入
+    template<typename T>
+    size_t EstimateHeapSize(const T &value) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8_t> >) {
+            return value.capacity();
+        } else {
+            return 0;
+        }
+    }
+
+    template<typename... Ts>
+    size_t EstimateRowsSize(const std::vector<std::tuple<Ts...> > &rows) {
+        size_t bytes = sizeof(rows) + rows.capacity() * sizeof(std::tuple<Ts...>);
+        for (const auto &row: rows) {
+            bytes += std::apply([](const auto &... values) {
+                return (EstimateHeapSize(values) + ... + 0);
+            }, row);
+        }
+        return bytes;
+    }
+
+    // 以型別標記 + 原始位元組序列化參數，避免 1 與 "1" 產生相同的 key
+    template<typename T>
+    void AppendCacheKey(std::string &key, const T &value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            key += 's';
+            key += std::to_string(value.size());
+            key += ':';
+            key += value;
+        } else if constexpr (std::is_same_v<T, const char *> || std::is_same_v<std::decay_t<T>, char *>) {
+            AppendCacheKey(key, std::string(value));
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            key += std::is_floating_point_v<T> ? 'f' : 'i';
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            key.append(bytes, sizeof(T));
+        } else if constexpr (requires { value.AppendCacheKey(key); }) {
+            value.AppendCacheKey(key);
+        } else {
+            static_assert([]() { return false; }(), "Unsupported type for query cache key");
+        }
+    }
+
+    // 已實體化查詢結果的 LRU 快取，依資料表失效
+    class QueryCache {
+        struct Entry {
+            std::string key;
+            std::shared_ptr<const void> rows;
+            size_t bytes;
+            std::vector<std::string> tables;
+        };
+
+        std::list<Entry> _lru; // 前端為最近使用
+        std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+        std::unordered_map<std::string, std::unordered_set<std::string> > _keysByTable;
+        QueryCacheStats _stats;
+        int64_t _dataVersion = -1;
+        int64_t _observedChanges = 0;
+        int64_t _unobservedChanges = -1;
+
+        static std::string NormalizeTableName(std::string table) {
+            for (auto &c: table) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            return table;
+        }
+
+        void Erase(std::list<Entry>::iterator it) {
+            for (const auto &table: it->tables) {
+                auto keys = _keysByTable.find(table);
+                if (keys != _keysByTable.end()) {
+                    keys->second.erase(it->key);
+                    if (keys->second.empty()) {
+                        _keysByTable.erase(keys);
+                    }
+                }
+            }
+            _stats.bytes -= it->bytes;
+            _index.erase(it->key);
+            _lru.erase(it);
+        }
+
+    public:
+        explicit QueryCache(size_t maxBytes) {
+            _stats.maxBytes = maxBytes;
+        }
+
+        template<typename Row, typename... Parameters>
+        static std::string MakeKey(const std::string &sql, const Parameters &... parameters) {
+            // 結果型別也納入 key，相同 SQL 以不同 C++ 型別讀取時不會互相誤用
+            std::string key = typeid(Row).name();
+            key += '\0';
+            key += sql;
+            key += '\0';
+            (AppendCacheKey(key, parameters), ...);
+            return key;
+        }
+
+        template<typename Rows>
+        std::shared_ptr<const Rows> Find(const std::string &key) {
+            auto it = _index.find(key);
+            if (it == _index.end()) {
+                ++_stats.misses;
+                return nullptr;
+            }
+            ++_stats.hits;
+            _lru.splice(_lru.begin(), _lru, it->second);
+            return std::static_pointer_cast<const Rows>(it->second->rows);
+        }
+
+        template<typename Rows>
+        void Store(const std::string &key, std::shared_ptr<const Rows> rows, size_t bytes,
+                   const std::vector<std::string> &tables) {
+            bytes += key.size() + sizeof(Entry);
+            if (bytes > _stats.maxBytes) {
+                return;
+            }
+            if (auto it = _index.find(key); it != _index.end()) {
+                Erase(it->second);
+            }
+            while (_stats.bytes + bytes > _stats.maxBytes && !_lru.empty()) {
+                Erase(std::prev(_lru.end()));
+                ++_stats.evictions;
+            }
+            Entry entry{key, std::move(rows), bytes, {}};
+            for (const auto &table: tables) {
+                entry.tables.push_back(NormalizeTableName(table));
+                _keysByTable[entry.tables.back()].insert(key);
+            }
+            _lru.push_front(std::move(entry));
+            _index[key] = _lru.begin();
+            _stats.bytes += bytes;
+        }
+
+        void InvalidateTable(const std::string &table) {
+            auto keys = _keysByTable.find(NormalizeTableName(table));
+            if (keys == _keysByTable.end()) {
+                return;
+            }
+            auto toErase = keys->second;
+            for (const auto &key: toErase) {
+                Erase(_index.at(key));
+                ++_stats.invalidations;
+            }
+        }
+
+        void Clear() {
+            _stats.invalidations += _lru.size();
+            _lru.clear();
+            _index.clear();
+            _keysByTable.clear();
+            _stats.bytes = 0;
+        }
+
+        // 由 sqlite3_update_hook 呼叫
+        void OnRowChanged(const char *table) {
+            ++_observedChanges;
+            InvalidateTable(table);
+        }
+
+        // 查詢前同步：data_version 變動代表其他連線已提交；
+        // total_changes 與 update hook 次數不一致代表有 hook 看不到的變更（例如 WITHOUT ROWID 或 truncate），整個清空
+        void Sync(int64_t dataVersion, int64_t totalChanges) {
+            if (_dataVersion != -1 && _dataVersion != dataVersion) {
+                Clear();
+            }
+            _dataVersion = dataVersion;
+            auto unobserved = totalChanges - _observedChanges;
+            if (_unobservedChanges != -1 && _unobservedChanges != unobserved) {
+                Clear();
+            }
+            _unobservedChanges = unobserved;
+        }
+
+        QueryCacheStats Stats() const {
+            auto stats = _stats;
+            stats.entries = _lru.size();
+            return stats;
+        }
+    };
+}
@@ -45,6 +45,20 @@ namespace TypeSQLite {
     template<typename T>
     concept ColumnOrTableColumnConcept = TableColumnConcept<T> || ColumnConcept<T>;
 
+    template<DataType Type, typename>
+    struct IsNotNullConstraintGroup;
+
+    // NOT NULL，或 INTEGER PRIMARY KEY（rowid 的別名）；其他型別的 PRIMARY KEY 在 SQLite 中仍可為 NULL
+    template<DataType Type, typename... Constraints>
+    struct IsNotNullConstraintGroup<Type, TypeGroup<Constraints...> >
+            : std::bool_constant<(IsNotNullConstraint<Constraints>::value || ...) ||
+                                 (Type == DataType::INTEGER && (IsPrimaryKeyConstraint<Constraints>::value || ...))> {
+    };
+
+    template<typename T>
+    concept NotNullColumnConcept = ColumnOrTableColumnConcept<T> &&
+                                   IsNotNullConstraintGroup<T::type, typename T::constraints>::value;
+
     //TODO 暫時先放寬約束
     template<typename/*ColumnOrTableColumnConcept*/ T>
     constexpr auto GetColumnName(T t) {
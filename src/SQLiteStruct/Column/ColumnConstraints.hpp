@@ -78,6 +78,22 @@ namespace TypeSQLite {
     template<typename T>
     concept ColumnConstraintConcept = IsColumnConstraint<T>::value;
 
+    template<typename>
+    struct IsNotNullConstraint : std::false_type {
+    };
+
+    template<ConflictCause conflictCause>
+    struct IsNotNullConstraint<ColumnNotNull<conflictCause> > : std::true_type {
+    };
+
+    template<typename>
+    struct IsPrimaryKeyConstraint : std::false_type {
+    };
+
+    template<OrderType order, ConflictCause conflictCause, bool autoIncrement>
+    struct IsPrimaryKeyConstraint<ColumnPrimaryKey<order, conflictCause, autoIncrement> > : std::true_type {
+    };
+
     template<typename>
     struct IsColumnConstraintGroup : std::false_type {
     };
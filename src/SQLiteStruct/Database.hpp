@@ -1,8 +1,15 @@
 #pragma once
 #include "Query/Table.hpp"
 #include "Query/Index.hpp"
+#include "Query/ContainerTable.hpp"
+#include "Query/TempTable.hpp"
+#include "Query/CommonTableExpression.hpp"
+#include "Expressions/UserFunctions.hpp"
 #include "../TemplateHelper/FixedString.hpp"
 #include "../SQLiteWrapper.hpp"
+#include "../Changeset.hpp"
+#include "../Backup.hpp"
+#include "../MemoryStats.hpp"
 
 namespace TypeSQLite {
     template<typename T>
@@ -46,6 +53,9 @@ namespace TypeSQLite {
 
     template<TableOrIndexConcept... TableOrIndexDefs>
     class Database {
+        template<TableOrIndexConcept...>
+        friend class Database;
+
     public:
         // 使用 SQLiteWrapper 的 Transaction
         using Transaction = SQLiteWrapper::Transaction;
@@ -57,6 +67,28 @@ namespace TypeSQLite {
         decltype(CreateIndexes<TableOrIndexDefs...>(std::declval<SQLiteWrapper &>(),
                                                     std::declval<TableOrIndexDefs>()...)) _indexes;
 
+        enum class ImageMode {
+            READWRITE,
+            READONLY,
+            NO_COPY,
+        };
+
+        static SQLiteWrapper &LoadImage(SQLiteWrapper &sqlite, std::span<const uint8_t> image, ImageMode mode) {
+            if (mode == ImageMode::NO_COPY) {
+                sqlite.DeserializeNoCopy(image);
+            } else {
+                sqlite.Deserialize(image, mode == ImageMode::READONLY);
+            }
+            return sqlite;
+        }
+
+        // 必須在建立 Table 之前載入映像，資料表已存在時 CREATE TABLE IF NOT EXISTS 不會寫入
+        Database(std::span<const uint8_t> image, ImageMode mode, TableOrIndexDefs... table_defs)
+            : _sqlite(":memory:"),
+              _tables(CreateTables(LoadImage(_sqlite, image, mode), table_defs...)),
+              _indexes(CreateIndexes(_sqlite, table_defs...)) {
+        }
+
     public:
         explicit Database(const std::string &db_path, TableOrIndexDefs... table_defs)
             : _sqlite(db_path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE),
@@ -64,6 +96,45 @@ namespace TypeSQLite {
               _indexes(CreateIndexes(_sqlite, table_defs...)) {
         }
 
+        Database(const std::string &db_path, const OpenOptions &options, TableOrIndexDefs... table_defs)
+            : _sqlite(db_path, options),
+              _tables(CreateTables(_sqlite, table_defs...)),
+              _indexes(CreateIndexes(_sqlite, table_defs...)) {
+        }
+
+        // 從 Serialize() 產生的映像建立記憶體資料庫；FromImageNoCopy 直接使用 image 的記憶體（唯讀，需存活到 Database 解構）
+        static Database FromImage(std::span<const uint8_t> image, bool readonly, TableOrIndexDefs... table_defs) {
+            return Database(image, readonly ? ImageMode::READONLY : ImageMode::READWRITE, table_defs...);
+        }
+
+        static Database FromImageNoCopy(std::span<const uint8_t> image, TableOrIndexDefs... table_defs) {
+            return Database(image, ImageMode::NO_COPY, table_defs...);
+        }
+
+        std::vector<uint8_t> Serialize() const {
+            return _sqlite.Serialize();
+        }
+
+        // 行程的 sqlite3_status64 與此連線的 sqlite3_db_status
+        MemoryStatsSnapshot MemoryStats(bool reset = false) const {
+            return GetMemoryStats(_sqlite._dbPtr.get(), reset);
+        }
+
+        // 每隔 interval 取樣一次行程的 sqlite3_status64；不會在背景執行緒讀取此連線
+        static std::unique_ptr<MemoryStatsSampler> SampleMemoryStats(std::chrono::milliseconds interval,
+                                                                     MemoryStatsSampler::Callback callback) {
+            return std::make_unique<MemoryStatsSampler>(interval, std::move(callback));
+        }
+
+        // 透過 PRAGMA mmap_size 讀回的實際值
+        int64_t GetMmapSize() const {
+            return _sqlite.GetMmapSize();
+        }
+
+        int64_t SetMmapSize(int64_t bytes) {
+            return _sqlite.SetMmapSize(bytes);
+        }
+
         template<typename T>
         auto &GetTable() {
             return std::get<Table<T> >(_tables);
@@ -74,6 +145,118 @@ namespace TypeSQLite {
             return std::get<Index<T> >(_indexes);
         }
 
+        // 啟用 SelectStatement::CachedResults 使用的查詢結果快取，寫入時依資料表自動失效
+        void EnableQueryCache(size_t maxBytes) {
+            _sqlite.EnableQueryCache(maxBytes);
+        }
+
+        void DisableQueryCache() {
+            _sqlite.DisableQueryCache();
+        }
+
+        void ClearQueryCache() {
+            _sqlite.ClearQueryCache();
+        }
+
+        QueryCacheStats GetQueryCacheStats() const {
+            return _sqlite.GetQueryCacheStats();
+        }
+
+        // 訂閱資料庫的變更，解構回傳的 ChangeStream 即停止訂閱（必須先於 Database 解構）
+        std::unique_ptr<ChangeStream> Subscribe(ChangeStream::Consumer consumer, ChangeStreamOptions options = {}) {
+            return std::make_unique<ChangeStream>(_sqlite, std::move(consumer), std::move(options));
+        }
+
+        // 註冊純量函式，參數與回傳型別由 function 推導；回傳的工廠可像內建函式一樣用在 Where/Select。
+        // 用於索引運算式時，每個連線都必須在使用該索引前註冊
+        template<FixedString Name, typename F>
+        auto RegisterFunction(F function, const FunctionOptions &options = {}) {
+            return RegisterScalarFunction<Name>(_sqlite._dbPtr.get(), std::move(function), options);
+        }
+
+        // 註冊聚合函式類別 A（Step/Final），若另有 Inverse/Value 也可透過 Over 作為視窗函式使用
+        template<FixedString Name, UserAggregateConcept A>
+        auto RegisterAggregate(const FunctionOptions &options = {}) {
+            return RegisterAggregateFunction<Name, A>(_sqlite._dbPtr.get(), options);
+        }
+
+        // 將容器以名為 Name 的虛擬表提供給查詢使用，不複製資料；Row 為純量或 tuple，每個元素對應一個欄位
+        template<FixedString Name, typename Row, ColumnConcept... Cols>
+        ContainerTable<Name, Row, std::tuple<Cols...> > AttachContainer(std::span<const Row> rows, Cols... cols) {
+            return ContainerTable<Name, Row, std::tuple<Cols...> >(_sqlite, rows, std::make_tuple(cols...));
+        }
+
+        template<FixedString Name, typename Row, ColumnConcept... Cols>
+        ContainerTable<Name, Row, std::tuple<Cols...> > AttachContainer(const std::vector<Row> &rows, Cols... cols) {
+            return AttachContainer<Name>(std::span<const Row>(rows), cols...);
+        }
+
+        // 建立 TEMP 資料表暫存外部的鍵值，讓批次刪除/更新以單一語句完成；
+        // store 會設定整個連線的 temp_store，變更時會捨棄整個 temp schema，
+        // 因此已有暫存表時只能沿用目前的設定
+        template<TableDefinitionConcept Def>
+        TypeSQLite::TempTable<Def> TempTable(TempStore store = TempStore::DEFAULT, Def tableDef = Def{}) {
+            if (store != TempStore::DEFAULT) {
+                auto current = std::get<0>(*_sqlite.Query<int>("PRAGMA temp_store;").begin());
+                if (current != static_cast<int>(store)) {
+                    auto tempTables = std::get<0>(*_sqlite.Query<int64_t>(
+                        "SELECT COUNT(*) FROM temp.sqlite_master WHERE type = 'table';").begin());
+                    if (tempTables > 0) {
+                        throw std::logic_error("Cannot change temp_store while temporary tables exist");
+                    }
+                    _sqlite.Execute("PRAGMA temp_store = " + std::string(GetTempStoreString(store)) + ";");
+                }
+            }
+            return TypeSQLite::TempTable<Def>(_sqlite, tableDef);
+        }
+
+        // 將 SELECT 命名為 CTE，作為其他查詢的來源；未指定欄位時沿用結果欄位
+        template<FixedString Name, SelectStatementConcept Statement, ColumnConcept... Cols>
+        auto With(const Statement &statement, Cols... cols) {
+            return MakeCommonTableExpression<Name>(_sqlite, statement, cols...);
+        }
+
+        // WITH RECURSIVE：recursive 接收 CTE 自己，回傳與 anchor 以 UNION ALL 合併的遞迴成員，
+        // 整個走訪在單一語句內完成
+        template<FixedString Name, SelectStatementConcept Anchor, typename Recursive, ColumnConcept... Cols>
+        auto WithRecursive(const Anchor &anchor, Recursive recursive, Cols... cols) {
+            return MakeRecursiveCommonTableExpression<Name>(_sqlite, anchor, std::move(recursive), cols...);
+        }
+
+#ifdef SQLITE_ENABLE_SESSION
+        // 記錄指定資料表（未指定則為所有資料表）的變更，透過回傳物件取得變更集
+        template<TableDefinitionConcept... Defs>
+        ChangeRecorder RecordChanges() {
+            if constexpr (sizeof...(Defs) == 0) {
+                return ChangeRecorder(_sqlite, std::apply([](const auto &... tables) {
+                    return std::vector<std::string>{std::string(std::remove_cvref_t<decltype(tables)>::name)...};
+                }, _tables));
+            } else {
+                return ChangeRecorder(_sqlite, {std::string(Defs::name)...});
+            }
+        }
+
+        void ApplyChangeset(const Changeset &changeset, ConflictCause policy = ConflictCause::ABORT) {
+            TypeSQLite::ApplyChangeset(_sqlite, changeset, policy);
+        }
+#endif
+
+        // 線上備份到檔案，備份期間其他連線仍可讀寫；被取消時回傳 false
+        bool BackupTo(const std::string &path, const BackupOptions &options = {}) {
+            SQLiteWrapper destination(path);
+            return Backup(_sqlite._dbPtr.get(), destination._dbPtr.get(), options);
+        }
+
+        template<TableOrIndexConcept... OtherDefs>
+        bool BackupTo(Database<OtherDefs...> &destination, const BackupOptions &options = {}) {
+            return Backup(_sqlite._dbPtr.get(), destination._sqlite._dbPtr.get(), options);
+        }
+
+        // 產生重整過的副本，目標檔案必須不存在
+        void VacuumInto(const std::string &path) {
+            _sqlite.Execute("VACUUM INTO ?;", path);
+        }
+
         void CreateTransaction(const std::function<void(Transaction &)> &callback) {
             Transaction transaction(_sqlite);
             callback(transaction);
@@ -1,66 +1,136 @@
 #pragma once
+#include <string>
+#include <type_traits>
+
 #include "../../TemplateHelper/FixedString.hpp"
 #include "./Expressions.hpp"
+#include "./WindowFunctions.hpp"
 
-//TODO Aggregate Functions有WindowFunction的特性
 namespace TypeSQLite {
+    // 聚合函式：可直接用於 Select/GroupBy，
+    // 也可加上 Over/PartitionedBy/OrderBy/框架 成為視窗函式，由 SQLite 的視窗引擎以單次排序計算；
+    // 未提供 xValue/xInverse 的自訂聚合 IsWindow 為 false，SQLite 不允許其搭配 OVER
+    template<typename ReturnType, typename Columns, typename Parameters, bool IsWindow = true>
+    struct AggregateFunction : Expressions<ReturnType, Columns, Parameters> {
+        // FILTER (WHERE ...)：只聚合符合條件的列，多個條件統計可在同一次掃描完成
+        template<ExprOrColConcept Where>
+        auto Filter(const Where &where) const {
+            auto newCols = std::tuple_cat(this->cols, GetCols(where));
+            auto newPara = std::tuple_cat(this->params, GetParms(where));
+            return AggregateFunction<ReturnType, decltype(newCols), decltype(newPara), IsWindow>{
+                {
+                    .cols = newCols,
+                    .sql = this->sql + " FILTER (WHERE " + where.sql + ")",
+                    .params = newPara
+                }
+            };
+        }
+
+        // OVER()：整個結果集為同一個視窗
+        auto Over() const requires IsWindow {
+            return MakeWindowFunction<ReturnType>(" " + this->sql, Expressions<ReturnType, Columns, Parameters>(*this));
+        }
+
+        template<WindowDefinitionConcept Window> requires IsWindow
+        auto Over(const Window &window) const {
+            return Over().Over(window);
+        }
+
+        template<ExprOrColConcept... Exprs> requires IsWindow
+        auto PartitionedBy(Exprs... exprs) const {
+            return Over().PartitionedBy(exprs...);
+        }
+
+        template<ExprOrColConcept Expr> requires IsWindow
+        auto OrderBy(Expr expr, const OrderType order) const {
+            return Over().OrderBy(expr, order);
+        }
+
+        template<OrderingTermOrExprConcept... Terms> requires IsWindow
+        auto OrderBy(Terms... terms) const {
+            return Over().OrderBy(terms...);
+        }
+
+        auto Rows(const FrameBound &start, const FrameBound &end,
+                  FrameExclude exclude = FrameExclude::NO_OTHERS) const requires IsWindow {
+            return Over().Rows(start, end, exclude);
+        }
+
+        auto Range(const FrameBound &start, const FrameBound &end,
+                   FrameExclude exclude = FrameExclude::NO_OTHERS) const requires IsWindow {
+            return Over().Range(start, end, exclude);
+        }
+
+        auto Groups(const FrameBound &start, const FrameBound &end,
+                    FrameExclude exclude = FrameExclude::NO_OTHERS) const requires IsWindow {
+            return Over().Groups(start, end, exclude);
+        }
+    };
+
+    template<typename ReturnType, bool IsWindow = true, ExprOrColConcept... Exprs>
+    auto MakeAggregateFunction(std::string newSQL, Exprs... exprs) {
+        auto expr = MakeExpr<ReturnType>(std::move(newSQL), exprs...);
+        return AggregateFunction<ReturnType, std::remove_const_t<decltype(expr.cols)>,
+            std::remove_const_t<decltype(expr.params)>, IsWindow>{expr};
+    }
+
     // AVG - Average value
     template<ExprOrColConcept T>
     auto Avg(const T &expr) {
-        return MakeExpr<double>("AVG(" + expr.sql + ")",expr);
+        return MakeAggregateFunction<double>("AVG(" + expr.sql + ")", expr);
     }
 
     // COUNT - Count rows
     template<ExprOrColConcept T>
     auto Count(const T &expr) {
-        return MakeExpr<double>("COUNT(" + expr.sql + ")",expr);
+        return MakeAggregateFunction<double>("COUNT(" + expr.sql + ")", expr);
     }
 
     // MAX - Maximum value
     template<ExprOrColConcept T>
     auto Max(const T &expr) {
-        return MakeExpr<double>("MAX(" + expr.sql + ")",expr);
+        return MakeAggregateFunction<double>("MAX(" + expr.sql + ")", expr);
     }
 
     // MIN - Minimum value
     template<ExprOrColConcept T>
     auto Min(const T &expr) {
-        return MakeExpr<double>("MIN(" + expr.sql + ")",expr);
+        return MakeAggregateFunction<double>("MIN(" + expr.sql + ")", expr);
     }
 
     // SUM - Sum of values
     template<ExprOrColConcept T>
     auto Sum(const T &expr) {
-        return MakeExpr<double>("SUM(" + expr.sql + ")",expr);
+        return MakeAggregateFunction<double>("SUM(" + expr.sql + ")", expr);
     }
 
     // TOTAL - Total of values (returns 0.0 for empty set instead of NULL)
     template<ExprOrColConcept T>
     auto Total(const T &expr) {
-        return MakeExpr<double>("TOTAL(" + expr.sql + ")",expr);
+        return MakeAggregateFunction<double>("TOTAL(" + expr.sql + ")", expr);
     }
 
     // GROUP_CONCAT - Concatenate strings with separator
     template<ExprOrColConcept T1, ExprOrColConcept T2>
     auto GroupConcat(const T1 &expr1, const T2 &expr2) {
-        return MakeExpr<"GROUP_CONCAT(" + T1::sql + ", " + T2::sql + ")">(expr1, expr2);
+        return MakeAggregateFunction<std::string>("GROUP_CONCAT(" + expr1.sql + ", " + expr2.sql + ")", expr1, expr2);
     }
 
     // MEDIAN - Median value
     template<ExprOrColConcept T>
     auto Median(const T &expr) {
-        return MakeExpr<double>("MEDIAN(" + expr.sql + ")",expr);
+        return MakeAggregateFunction<double>("MEDIAN(" + expr.sql + ")", expr);
     }
 
     // PERCENTILE - Percentile value
     template<double percent, ExprOrColConcept T>
     auto Percentile(const T &expr) {
-        return MakeExpr<double>("PERCENTILE(" + expr.sql + ", " + toFixedString<percent>() + ")",expr);
+        return MakeAggregateFunction<double>("PERCENTILE(" + expr.sql + ", " + toFixedString<percent>() + ")", expr);
     }
 
     // PERCENTILE_CONT - Continuous percentile value
     template<double percent, ExprOrColConcept T>
     auto PercentileCont(const T &expr) {
-        return MakeExpr<double>("PERCENTILE_CONT(" + expr.sql + ", " + toFixedString<percent>() + ")",expr);
+        return MakeAggregateFunction<double>("PERCENTILE_CONT(" + expr.sql + ", " + toFixedString<percent>() + ")", expr);
     }
 }
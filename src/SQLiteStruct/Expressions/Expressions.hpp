@@ -3,7 +3,10 @@
 #include <tuple>
 #include <type_traits>
 #include <concepts>
+#include <span>
 #include <string>
+#include <string_view>
+#include "../../ArrayBinding.hpp"
 #include "../Column/Column.hpp"
 #include "../DataType.hpp"
 
@@ -28,6 +31,16 @@ namespace TypeSQLite {
         std::decay_t<
             decltype(std::declval<T>().params)> > >);
 
+    // Select(...) 與複合查詢：sql 為加上括號的子查詢，可用於 In/Exists 與 CTE
+    template<typename T>
+    concept SelectStatementConcept = ExpressionsConcept<T> && requires(const T &t)
+    {
+        typename T::Row;
+        typename T::ResultColumns;
+        { t.StatementSql() } -> std::convertible_to<std::string>;
+        { t.CompoundOperandSql(false) } -> std::convertible_to<std::string>;
+    };
+
     template<typename T>
     concept NullAbleExpr = ExpressionsConcept<T> && std::is_same_v<T, std::nullptr_t>;
 
@@ -87,6 +100,16 @@ namespace TypeSQLite {
     template<typename T>
     using ExprOrColReturnType = typename ExprOrColReturnTypeImpl<T>::type;
 
+    // 將 C++ 值綁定為 ? 參數
+    template<typename T>
+    auto MakeParamExpr(const T &value) {
+        return Expressions<T, std::tuple<>, std::tuple<T> >{
+            .cols = std::tuple<>{},
+            .sql = "?",
+            .params = std::make_tuple(value)
+        };
+    }
+
     // sqlite literal
     inline auto operator""_expr(const char *str, size_t) {
         return Expressions<std::string, std::tuple<>, std::tuple<std::string> >{
@@ -238,7 +261,51 @@ namespace TypeSQLite {
         return MakeExpr<double>(left.sql + " MATCH " + right.sql, left, right);
     }
 
-    //TODO 確認In功能
+    // IN 子查詢：right 為 Select(...) 產生的子查詢，其 sql 已包含括號
+    template<ExprOrColConcept Lhs, SelectStatementConcept Rhs>
+    auto In(const Lhs &left, const Rhs &right) {
+        return MakeExpr<double>(left.sql + " IN " + right.sql, left, right);
+    }
+
+    template<ExprOrColConcept Lhs, SelectStatementConcept Rhs>
+    auto NotIn(const Lhs &left, const Rhs &right) {
+        return MakeExpr<double>(left.sql + " NOT IN " + right.sql, left, right);
+    }
+
+    // 子查詢可直接使用外層查詢的 table[column]，形成相關子查詢（semi-join/anti-join）
+    template<SelectStatementConcept SubQuery>
+    auto Exists(const SubQuery &subQuery) {
+        return MakeExpr<double>("EXISTS " + subQuery.sql, subQuery);
+    }
+
+    template<SelectStatementConcept SubQuery>
+    auto NotExists(const SubQuery &subQuery) {
+        return MakeExpr<double>("NOT EXISTS " + subQuery.sql, subQuery);
+    }
+
+#ifdef SQLITE_ENABLE_CARRAY
+    // 以 carray(?) 將整個陣列綁定為單一參數，SQL 與陣列長度無關；values 必須存活到查詢結果讀取完畢
+    template<ExprOrColConcept Lhs, typename T>
+    auto InArray(const Lhs &left, std::span<const T> values) {
+        return MakeExpr<double>(left.sql + " IN " + ArrayFunctionName + "(?)", left,
+                                MakeParamExpr(ArrayParam<T>{values}));
+    }
+
+    template<ExprOrColConcept Lhs>
+    auto In(const Lhs &left, std::span<const int64_t> values) {
+        return InArray(left, values);
+    }
+
+    template<ExprOrColConcept Lhs>
+    auto In(const Lhs &left, std::span<const std::string_view> values) {
+        return InArray(left, values);
+    }
+
+    template<ExprOrColConcept Lhs>
+    auto In(const Lhs &left, std::span<const std::string> values) {
+        return InArray(left, values);
+    }
+#endif
 
     template<ExprOrColConcept Lhs, ExprOrColConcept Mid, ExprOrColConcept Rhs>
     auto Between(const Lhs &left, const Mid &mid, const Rhs &right) {
@@ -271,6 +338,85 @@ namespace TypeSQLite {
         }
     }
 
+    // CASE 各分支的共同回傳型別，尚無分支時為 void
+    template<typename Current, typename Branch>
+    struct CaseReturnTypeImpl {
+        static_assert(requires { typename std::common_type<Current, Branch>::type; },
+                      "CASE branches must have compatible return types");
+        using type = std::common_type_t<Current, Branch>;
+    };
+
+    template<typename Branch>
+    struct CaseReturnTypeImpl<void, Branch> {
+        using type = Branch;
+    };
+
+    template<typename Current, typename Branch>
+    using CaseReturnType = typename CaseReturnTypeImpl<Current, Branch>::type;
+
+    // 依序加入 When 分支，最後以 Else 或 End 產生運算式
+    template<typename ReturnType, typename Cols, typename Params>
+    struct CaseBuilder {
+        std::string sql;
+        Cols cols;
+        Params params;
+
+        // 搜尋式 CASE 的 cond 為條件；簡單 CASE 的 cond 為與 operand 比較的值
+        template<ExprOrColConcept Cond, ExprOrColConcept Value>
+        auto When(const Cond &cond, const Value &value) const {
+            auto newCols = std::tuple_cat(cols, GetCols(cond), GetCols(value));
+            auto newPara = std::tuple_cat(params, GetParms(cond), GetParms(value));
+            return CaseBuilder<CaseReturnType<ReturnType, ExprOrColReturnType<Value> >,
+                decltype(newCols), decltype(newPara)>{
+                .sql = sql + " WHEN " + cond.sql + " THEN " + value.sql,
+                .cols = newCols,
+                .params = newPara
+            };
+        }
+
+        template<ExprOrColConcept Value>
+        auto Else(const Value &value) const {
+            static_assert(!std::is_void_v<ReturnType>, "CASE requires at least one When");
+            auto newCols = std::tuple_cat(cols, GetCols(value));
+            auto newPara = std::tuple_cat(params, GetParms(value));
+            return Expressions<CaseReturnType<ReturnType, ExprOrColReturnType<Value> >,
+                decltype(newCols), decltype(newPara)>{
+                .cols = newCols,
+                .sql = sql + " ELSE " + value.sql + " END",
+                .params = newPara
+            };
+        }
+
+        // 沒有 ELSE，不符合任何分支時為 NULL
+        auto End() const {
+            static_assert(!std::is_void_v<ReturnType>, "CASE requires at least one When");
+            return Expressions<ReturnType, Cols, Params>{
+                .cols = cols,
+                .sql = sql + " END",
+                .params = params
+            };
+        }
+    };
+
+    // 搜尋式 CASE WHEN cond THEN value ... END
+    inline auto Case() {
+        return CaseBuilder<void, std::tuple<>, std::tuple<> >{
+            .sql = "CASE",
+            .cols = std::tuple<>{},
+            .params = std::tuple<>{}
+        };
+    }
+
+    // 簡單 CASE operand WHEN value THEN result ... END
+    template<ExprOrColConcept Operand>
+    auto Case(const Operand &operand) {
+        return CaseBuilder<void, decltype(GetCols(operand)), decltype(GetParms(operand))>{
+            .sql = "CASE " + operand.sql,
+            .cols = GetCols(operand),
+            .params = GetParms(operand)
+        };
+    }
+
     template<typename /*ExprOrColConcept*/ expr, typename/*ExprOrColConcept*/... exprs>
     auto GetExprSqls(const expr &first, const exprs &... rest) {
         if constexpr (sizeof...(rest) == 0) {
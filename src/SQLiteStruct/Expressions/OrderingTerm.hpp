@@ -0,0 +1,121 @@
+#pragma once
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../Order.hpp"
+#include "./Expressions.hpp"
+
+namespace TypeSQLite {
+    // ORDER BY 的單一排序項：expr [COLLATE name] ASC|DESC [NULLS FIRST|LAST]
+    template<ExprOrColConcept Expr>
+    struct OrderingTerm {
+        Expr expr;
+        OrderType order = OrderType::ASC;
+        NullsOrder nulls = NullsOrder::DEFAULT;
+        std::string collation;
+
+        explicit OrderingTerm(Expr expr, OrderType order = OrderType::ASC, NullsOrder nulls = NullsOrder::DEFAULT,
+                              std::string collation = {})
+            : expr(std::move(expr)), order(order), nulls(nulls), collation(std::move(collation)) {
+        }
+
+        OrderingTerm NullsFirst() const {
+            return OrderingTerm{expr, order, NullsOrder::FIRST, collation};
+        }
+
+        OrderingTerm NullsLast() const {
+            return OrderingTerm{expr, order, NullsOrder::LAST, collation};
+        }
+
+        // 使用編譯期名稱避免將任意字串拼進 SQL
+        template<FixedString Name>
+        OrderingTerm Collate() const {
+            return OrderingTerm{expr, order, nulls, std::string(Name)};
+        }
+    };
+
+    template<typename>
+    struct IsOrderingTerm : std::false_type {
+    };
+
+    template<typename Expr>
+    struct IsOrderingTerm<OrderingTerm<Expr> > : std::true_type {
+    };
+
+    template<typename T>
+    concept OrderingTermConcept = IsOrderingTerm<T>::value;
+
+    template<typename T>
+    concept OrderingTermOrExprConcept = OrderingTermConcept<T> || ExprOrColConcept<T>;
+
+    template<ExprOrColConcept Expr>
+    auto Asc(const Expr &expr) {
+        return OrderingTerm<Expr>{expr, OrderType::ASC};
+    }
+
+    template<ExprOrColConcept Expr>
+    auto Desc(const Expr &expr) {
+        return OrderingTerm<Expr>{expr, OrderType::DESC};
+    }
+
+    template<OrderingTermOrExprConcept T>
+    auto ToOrderingTerm(const T &t) {
+        if constexpr (OrderingTermConcept<T>) {
+            return t;
+        } else {
+            return OrderingTerm<T>{t};
+        }
+    }
+
+    template<OrderingTermOrExprConcept... Terms>
+    auto MakeOrderBy(const Terms &... terms) {
+        return std::make_tuple(ToOrderingTerm(terms)...);
+    }
+
+    template<OrderingTermConcept Term>
+    std::string GetOrderingTermSql(const Term &term) {
+        auto sql = term.expr.sql;
+        if (!term.collation.empty()) {
+            sql += " COLLATE " + term.collation;
+        }
+        return sql + OrderTypeToString(term.order) + NullsOrderToString(term.nulls);
+    }
+
+    // OrderBy 為 OrderingTerm 的 tuple 或 nullptr
+    template<typename OrderBy>
+    std::string GetOrderBySql(const OrderBy &orderBy) {
+        if constexpr (std::is_null_pointer_v<OrderBy>) {
+            return "";
+        } else {
+            return std::apply([](const auto &... terms) {
+                std::string sql;
+                ((sql += (sql.empty() ? "" : ", ") + GetOrderingTermSql(terms)), ...);
+                return " ORDER BY " + sql;
+            }, orderBy);
+        }
+    }
+
+    template<typename OrderBy>
+    auto GetOrderByCols(const OrderBy &orderBy) {
+        if constexpr (std::is_null_pointer_v<OrderBy>) {
+            return std::tuple<>();
+        } else {
+            return std::apply([](const auto &... terms) {
+                return std::tuple_cat(GetCols(terms.expr)...);
+            }, orderBy);
+        }
+    }
+
+    template<typename OrderBy>
+    auto GetOrderByParams(const OrderBy &orderBy) {
+        if constexpr (std::is_null_pointer_v<OrderBy>) {
+            return std::tuple<>();
+        } else {
+            return std::apply([](const auto &... terms) {
+                return std::tuple_cat(GetParms(terms.expr)...);
+            }, orderBy);
+        }
+    }
+}
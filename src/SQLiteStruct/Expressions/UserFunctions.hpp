@@ -0,0 +1,305 @@
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../../TemplateHelper/FixedString.hpp"
+#include "../../SQLiteWrapper.hpp"
+#include "./Expressions.hpp"
+#include "./AggregateFunctions.hpp"
+#include "./WindowFunctions.hpp"
+
+namespace TypeSQLite {
+    // 從 lambda、函式物件或函式指標推導回傳型別與參數型別
+    template<typename F>
+    struct CallableTraits : CallableTraits<decltype(&F::operator())> {
+    };
+
+    template<typename R, typename... Args>
+    struct CallableTraits<R(*)(Args...)> {
+        using Return = R;
+        using Arguments = std::tuple<std::remove_cvref_t<Args>...>;
+    };
+
+    template<typename R, typename... Args>
+    struct CallableTraits<R(Args...)> : CallableTraits<R(*)(Args...)> {
+    };
+
+    template<typename C, typename R, typename... Args>
+    struct CallableTraits<R(C::*)(Args...)> : CallableTraits<R(*)(Args...)> {
+    };
+
+    template<typename C, typename R, typename... Args>
+    struct CallableTraits<R(C::*)(Args...) const> : CallableTraits<R(*)(Args...)> {
+    };
+
+    template<typename C, typename R, typename... Args>
+    struct CallableTraits<R(C::*)(Args...) noexcept> : CallableTraits<R(*)(Args...)> {
+    };
+
+    template<typename C, typename R, typename... Args>
+    struct CallableTraits<R(C::*)(Args...) const noexcept> : CallableTraits<R(*)(Args...)> {
+    };
+
+    template<typename T>
+    struct IsOptional : std::false_type {
+    };
+
+    template<typename T>
+    struct IsOptional<std::optional<T> > : std::true_type {
+    };
+
+    // sqlite3_value 轉為 C++ 參數；string_view 只在呼叫期間有效，NULL 需以 std::optional 接收
+    template<typename T>
+    T ReadValue(sqlite3_value *pValue) {
+        if constexpr (IsOptional<T>::value) {
+            if (sqlite3_value_type(pValue) == SQLITE_NULL) {
+                return std::nullopt;
+            }
+            return ReadValue<typename T::value_type>(pValue);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return sqlite3_value_int64(pValue) != 0;
+        } else if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(sqlite3_value_int64(pValue));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(sqlite3_value_double(pValue));
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            auto pText = reinterpret_cast<const char *>(sqlite3_value_text(pValue));
+            return T(pText ? pText : "", static_cast<size_t>(sqlite3_value_bytes(pValue)));
+        } else if constexpr (std::is_same_v<T, std::vector<uint8_t> >) {
+            auto pBytes = static_cast<const uint8_t *>(sqlite3_value_blob(pValue));
+            return pBytes ? T(pBytes, pBytes + sqlite3_value_bytes(pValue)) : T{};
+        } else {
+            static_assert([]() { return false; }(), "Unsupported argument type for user function");
+        }
+    }
+
+    template<typename T>
+    void SetResult(sqlite3_context *pContext, const T &value) {
+        if constexpr (IsOptional<T>::value) {
+            if (value) {
+                SetResult(pContext, *value);
+            } else {
+                sqlite3_result_null(pContext);
+            }
+        } else if constexpr (std::is_null_pointer_v<T>) {
+            sqlite3_result_null(pContext);
+        } else if constexpr (std::is_integral_v<T>) {
+            sqlite3_result_int64(pContext, static_cast<sqlite3_int64>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            sqlite3_result_double(pContext, static_cast<double>(value));
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            sqlite3_result_text64(pContext, value.data(), value.size(), SQLITE_TRANSIENT, SQLITE_UTF8);
+        } else if constexpr (std::is_same_v<T, std::vector<uint8_t> >) {
+            sqlite3_result_blob64(pContext, value.data(), value.size(), SQLITE_TRANSIENT);
+        } else {
+            static_assert([]() { return false; }(), "Unsupported return type for user function");
+        }
+    }
+
+    // 對應到 GetValue 可讀取的型別
+    template<typename T>
+    struct SqlValueTypeImpl {
+        using type = std::conditional_t<std::is_integral_v<T> && (sizeof(T) > sizeof(int)), int64_t,
+            std::conditional_t<std::is_integral_v<T>, int,
+                std::conditional_t<std::is_floating_point_v<T>, double, T> > >;
+    };
+
+    template<typename T>
+    struct SqlValueTypeImpl<std::optional<T> > : SqlValueTypeImpl<T> {
+    };
+
+    template<>
+    struct SqlValueTypeImpl<std::string_view> {
+        using type = std::string;
+    };
+
+    template<typename T>
+    using SqlValueType = typename SqlValueTypeImpl<std::remove_cvref_t<T> >::type;
+
+    struct FunctionOptions {
+        bool deterministic = true; // 相同輸入必得相同結果，可用於索引運算式與查詢最佳化
+        bool innocuous = true; // 沒有副作用，可在 trigger 與 view 中使用
+        bool directOnly = false; // 只能在最外層 SQL 中呼叫
+    };
+
+    inline int GetFunctionFlags(const FunctionOptions &options) {
+        return SQLITE_UTF8 |
+               (options.deterministic ? SQLITE_DETERMINISTIC : 0) |
+               (options.innocuous ? SQLITE_INNOCUOUS : 0) |
+               (options.directOnly ? SQLITE_DIRECTONLY : 0);
+    }
+
+    template<typename Arguments, typename F, size_t... I>
+    decltype(auto) InvokeWithValues(F &function, sqlite3_value **argv, std::index_sequence<I...>) {
+        return function(ReadValue<std::tuple_element_t<I, Arguments> >(argv[I])...);
+    }
+
+    template<FixedString Name, ExprOrColConcept... Exprs>
+    std::string GetFunctionCallSql(const Exprs &... exprs) {
+        if constexpr (sizeof...(Exprs) == 0) {
+            return std::string(Name.value) + "()";
+        } else {
+            return std::string(Name.value) + "(" + GetExprSqls(exprs...) + ")";
+        }
+    }
+
+    // 已註冊函式的運算式工廠，用法與 ScalarFunctions.hpp 中的內建函式相同
+    template<FixedString Name, size_t Arity, typename ReturnType>
+    struct UserFunction {
+        template<ExprOrColConcept... Exprs>
+        auto operator()(const Exprs &... exprs) const {
+            static_assert(sizeof...(Exprs) == Arity, "Argument count does not match the registered function");
+            return MakeExpr<ReturnType>(GetFunctionCallSql<Name>(exprs...), exprs...);
+        }
+    };
+
+    // 以 sqlite3_create_function_v2 註冊，SQLite 持有 function 的副本直到連線關閉或重新註冊
+    template<FixedString Name, typename F>
+    auto RegisterScalarFunction(sqlite3 *db, F function, const FunctionOptions &options = {}) {
+        using Traits = CallableTraits<F>;
+        using Arguments = typename Traits::Arguments;
+        constexpr auto Arity = std::tuple_size_v<Arguments>;
+
+        auto rc = sqlite3_create_function_v2(
+            db, Name.value, static_cast<int>(Arity), GetFunctionFlags(options), new F(std::move(function)),
+            [](sqlite3_context *pContext, int, sqlite3_value **argv) {
+                auto &callable = *static_cast<F *>(sqlite3_user_data(pContext));
+                try {
+                    if constexpr (std::is_void_v<typename Traits::Return>) {
+                        InvokeWithValues<Arguments>(callable, argv, std::make_index_sequence<Arity>{});
+                        sqlite3_result_null(pContext);
+                    } else {
+                        SetResult(pContext, InvokeWithValues<Arguments>(callable, argv,
+                                                                        std::make_index_sequence<Arity>{}));
+                    }
+                } catch (const std::exception &exception) {
+                    // 讓查詢以錯誤結束，不讓例外穿過 SQLite
+                    sqlite3_result_error(pContext, exception.what(), -1);
+                }
+            }, nullptr, nullptr,
+            // 註冊失敗時 SQLite 也會呼叫 xDestroy
+            [](void *pFunction) { delete static_cast<F *>(pFunction); });
+        if (rc != SQLITE_OK) {
+            throw std::runtime_error("Failed to register function " + std::string(Name.value) + ": " +
+                                     std::string(sqlite3_errmsg(db)));
+        }
+        return UserFunction<Name, Arity, SqlValueType<typename Traits::Return> >{};
+    }
+
+    // 自訂聚合函式：每個群組建立一個 A，逐列呼叫 Step，最後以 Final 的回傳值為結果
+    template<typename A>
+    concept UserAggregateConcept = std::default_initializable<A> && requires(A &aggregate) {
+        &A::Step;
+        aggregate.Final();
+    };
+
+    // 另外提供 Inverse（移出視窗的列）與 Value（目前視窗的結果）時可作為視窗函式
+    template<typename A>
+    concept UserWindowAggregateConcept = UserAggregateConcept<A> && requires(A &aggregate) {
+        &A::Inverse;
+        aggregate.Value();
+    };
+
+    // sqlite3_aggregate_context 只保存指標，A 本身配置在 heap 上以符合其對齊與建構需求
+    template<typename A>
+    A *GetAggregateState(sqlite3_context *pContext) {
+        auto ppState = static_cast<A **>(sqlite3_aggregate_context(pContext, sizeof(A *)));
+        if (!ppState) {
+            return nullptr;
+        }
+        if (!*ppState) {
+            *ppState = new A();
+        }
+        return *ppState;
+    }
+
+    template<typename A, auto Method>
+    void InvokeAggregateStep(sqlite3_context *pContext, sqlite3_value **argv) {
+        using Arguments = typename CallableTraits<decltype(Method)>::Arguments;
+        try {
+            auto pState = GetAggregateState<A>(pContext);
+            if (!pState) {
+                sqlite3_result_error_nomem(pContext);
+                return;
+            }
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (pState->*Method)(ReadValue<std::tuple_element_t<I, Arguments> >(argv[I])...);
+            }(std::make_index_sequence<std::tuple_size_v<Arguments> >{});
+        } catch (const std::exception &exception) {
+            sqlite3_result_error(pContext, exception.what(), -1);
+        }
+    }
+
+    // 沒有任何列時 Step 不會被呼叫，以預設建構的 A 產生結果
+    template<typename A, typename Getter>
+    void SetAggregateResult(sqlite3_context *pContext, A *pState, Getter getter) {
+        try {
+            if (pState) {
+                SetResult(pContext, getter(*pState));
+            } else {
+                A empty;
+                SetResult(pContext, getter(empty));
+            }
+        } catch (const std::exception &exception) {
+            sqlite3_result_error(pContext, exception.what(), -1);
+        }
+    }
+
+    template<FixedString Name, size_t Arity, typename ReturnType, bool IsWindow>
+    struct UserAggregate {
+        // 與內建聚合相同，可搭配 GroupBy、Filter；IsWindow 時可再接 Over/PartitionedBy/OrderBy
+        template<ExprOrColConcept... Exprs>
+        auto operator()(const Exprs &... exprs) const {
+            static_assert(sizeof...(Exprs) == Arity, "Argument count does not match the registered aggregate");
+            return MakeAggregateFunction<ReturnType, IsWindow>(GetFunctionCallSql<Name>(exprs...), exprs...);
+        }
+    };
+
+    template<FixedString Name, UserAggregateConcept A>
+    auto RegisterAggregateFunction(sqlite3 *db, const FunctionOptions &options = {}) {
+        using Arguments = typename CallableTraits<decltype(&A::Step)>::Arguments;
+        using ReturnType = SqlValueType<decltype(std::declval<A &>().Final())>;
+        constexpr auto Arity = std::tuple_size_v<Arguments>;
+        constexpr bool IsWindow = UserWindowAggregateConcept<A>;
+
+        auto xStep = [](sqlite3_context *pContext, int, sqlite3_value **argv) {
+            InvokeAggregateStep<A, &A::Step>(pContext, argv);
+        };
+        auto xFinal = [](sqlite3_context *pContext) {
+            auto ppState = static_cast<A **>(sqlite3_aggregate_context(pContext, 0));
+            std::unique_ptr<A> pState(ppState ? *ppState : nullptr);
+            SetAggregateResult(pContext, pState.get(), [](A &aggregate) { return aggregate.Final(); });
+        };
+        int rc;
+        if constexpr (IsWindow) {
+            static_assert(std::tuple_size_v<typename CallableTraits<decltype(&A::Inverse)>::Arguments> == Arity,
+                          "Inverse must take the same arguments as Step");
+            rc = sqlite3_create_window_function(
+                db, Name.value, static_cast<int>(Arity), GetFunctionFlags(options), nullptr, xStep, xFinal,
+                [](sqlite3_context *pContext) {
+                    auto ppState = static_cast<A **>(sqlite3_aggregate_context(pContext, 0));
+                    SetAggregateResult(pContext, ppState ? *ppState : nullptr,
+                                       [](A &aggregate) { return aggregate.Value(); });
+                },
+                [](sqlite3_context *pContext, int, sqlite3_value **argv) {
+                    InvokeAggregateStep<A, &A::Inverse>(pContext, argv);
+                }, nullptr);
+        } else {
+            rc = sqlite3_create_function_v2(db, Name.value, static_cast<int>(Arity), GetFunctionFlags(options),
+                                            nullptr, nullptr, xStep, xFinal, nullptr);
+        }
+        if (rc != SQLITE_OK) {
+            throw std::runtime_error("Failed to register aggregate " + std::string(Name.value) + ": " +
+                                     std::string(sqlite3_errmsg(db)));
+        }
+        return UserAggregate<Name, Arity, ReturnType, IsWindow>{};
+    }
+}
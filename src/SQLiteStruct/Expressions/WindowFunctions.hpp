@@ -1,39 +1,115 @@
 #pragma once
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 
+#include "../../TemplateHelper/FixedString.hpp"
 #include "../DataType.hpp"
 #include "../Column/Column.hpp"
 #include "../Expressions/Expressions.hpp"
+#include "../Expressions/OrderingTerm.hpp"
 
 namespace TypeSQLite {
     template<typename ReturnType, typename WindowFuncCols, typename WindowFuncParams, typename PartitionBy, typename
-        OrderExpr>
+        OrderBy>
     struct WindowFuncInfo {
         using returnType = ReturnType;
         const std::string windowFuncSql;
         const WindowFuncCols windowFuncCols;
         const WindowFuncParams windowFuncParams;
         PartitionBy partitionBy;
-        OrderExpr orderExpr;
-        OrderType orderType = OrderType::ASC;
+        OrderBy orderBy;
+        // ROWS/RANGE/GROUPS 子句，未指定時為空字串
+        std::string frame;
     };
 
     template<typename ReturnType, typename WindowFuncCols, typename WindowFuncParams, typename PartitionBy, typename
-        OrderExpr>
+        OrderBy>
     auto MakeInfo(std::string sql, WindowFuncCols cols, WindowFuncParams params, PartitionBy partitionBy,
-                  OrderExpr orderExpr, OrderType orderType = OrderType::ASC) {
-        return WindowFuncInfo<ReturnType, WindowFuncCols, WindowFuncParams, PartitionBy, OrderExpr>{
+                  OrderBy orderBy, std::string frame) {
+        return WindowFuncInfo<ReturnType, WindowFuncCols, WindowFuncParams, PartitionBy, OrderBy>{
             .windowFuncSql = sql,
             .windowFuncCols = cols,
             .windowFuncParams = params,
             .partitionBy = partitionBy,
-            .orderExpr = orderExpr,
-            .orderType = orderType
+            .orderBy = orderBy,
+            .frame = std::move(frame)
         };
     }
 
+    enum class FrameUnit {
+        ROWS,
+        RANGE,
+        GROUPS
+    };
+
+    enum class FrameExclude {
+        NO_OTHERS,
+        CURRENT_ROW,
+        GROUP,
+        TIES
+    };
+
+    // 視窗框架的邊界，位移量為常數直接寫入 SQL
+    struct FrameBound {
+        std::string sql;
+    };
+
+    template<typename T>
+    std::string GetFrameOffsetSql(T offset) {
+        static_assert(std::is_arithmetic_v<T>, "Frame offset must be a number");
+        // SQLite 只在執行時才回報負數位移，這裡提早拒絕
+        if (!(offset >= 0)) {
+            throw std::invalid_argument("Frame offset must be a non-negative number");
+        }
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), offset);
+        return std::string(buffer, result.ptr);
+    }
+
+    inline FrameBound UnboundedPreceding() {
+        return FrameBound{"UNBOUNDED PRECEDING"};
+    }
+
+    template<typename T>
+    FrameBound Preceding(T offset) {
+        return FrameBound{GetFrameOffsetSql(offset) + " PRECEDING"};
+    }
+
+    inline FrameBound CurrentRow() {
+        return FrameBound{"CURRENT ROW"};
+    }
+
+    template<typename T>
+    FrameBound Following(T offset) {
+        return FrameBound{GetFrameOffsetSql(offset) + " FOLLOWING"};
+    }
+
+    inline FrameBound UnboundedFollowing() {
+        return FrameBound{"UNBOUNDED FOLLOWING"};
+    }
+
+    inline std::string GetFrameSql(FrameUnit unit, const FrameBound &start, const FrameBound &end,
+                                   FrameExclude exclude) {
+        std::string sql = unit == FrameUnit::ROWS ? " ROWS" : unit == FrameUnit::RANGE ? " RANGE" : " GROUPS";
+        sql += " BETWEEN " + start.sql + " AND " + end.sql;
+        switch (exclude) {
+            case FrameExclude::CURRENT_ROW:
+                return sql + " EXCLUDE CURRENT ROW";
+            case FrameExclude::GROUP:
+                return sql + " EXCLUDE GROUP";
+            case FrameExclude::TIES:
+                return sql + " EXCLUDE TIES";
+            default:
+                return sql;
+        }
+    }
+
     template<typename NewInfo>
     std::string CreateSQLPartitionBy(const NewInfo &_info) {
         if constexpr (std::is_same_v<decltype(_info.partitionBy), nullptr_t>) {
@@ -47,36 +123,205 @@ namespace TypeSQLite {
 
     template<typename NewInfo>
     std::string CreateSQLOrderBy(const NewInfo &_info) {
-        if constexpr (std::is_same_v<decltype(_info.orderExpr), nullptr_t>) {
-            return "";
-        } else {
-            return " ORDER BY " + _info.orderExpr.sql + " " + OrderTypeToString(_info.orderType);
-        }
+        return GetOrderBySql(_info.orderBy);
+    }
+
+    // PARTITION BY、ORDER BY 與框架，視窗函式與 WindowDefinition 共用
+    template<typename NewInfo>
+    std::string GetWindowSpecSql(const NewInfo &_info) {
+        return CreateSQLPartitionBy(_info) + CreateSQLOrderBy(_info) + _info.frame;
     }
 
     template<typename NewInfo>
     auto GetSql(const NewInfo &_info) {
-        return _info.windowFuncSql + " OVER(" +
-               CreateSQLPartitionBy(_info) +
-               CreateSQLOrderBy(_info) +
-               ")";
+        return _info.windowFuncSql + " OVER(" + GetWindowSpecSql(_info) + ")";
     }
 
     template<typename NewInfo>
     auto GetInfoCols(const NewInfo &_info) {
         return std::tuple_cat(_info.windowFuncCols, GetExprsTupleColTuple(_info.partitionBy),
-                              GetExprsColTuple(_info.orderExpr));
+                              GetOrderByCols(_info.orderBy));
     }
 
     template<typename NewInfo>
     auto GetInfoParams(const NewInfo &_info) {
         return std::tuple_cat(_info.windowFuncParams, GetExprsTupleParamTuple(_info.partitionBy),
-                              GetExprsParamTuple(_info.orderExpr));
+                              GetOrderByParams(_info.orderBy));
+    }
+
+    // WINDOW name AS (...) 的定義，以 Select(...).Window(w) 加入語句，
+    // 多個視窗函式以 Over(w) 共用，SQLite 只需對分割排序一次
+    template<FixedString Name, typename Partition = std::nullptr_t, typename Order = std::nullptr_t>
+    struct WindowDefinition {
+        constexpr static FixedString name = Name;
+        Partition partitionBy;
+        Order orderBy;
+        std::string frame;
+
+        template<ExprOrColConcept... Exprs>
+        auto PartitionedBy(Exprs... exprs) const {
+            return WindowDefinition<Name, std::tuple<Exprs...>, Order>{std::make_tuple(exprs...), orderBy, frame};
+        }
+
+        template<ExprOrColConcept Expr>
+        auto OrderBy(Expr expr, const OrderType order) const {
+            return this->OrderBy(OrderingTerm<Expr>{expr, order});
+        }
+
+        template<OrderingTermOrExprConcept... Terms>
+        auto OrderBy(Terms... terms) const {
+            static_assert(sizeof...(Terms) > 0, "OrderBy requires at least one ordering term");
+            auto newOrderBy = MakeOrderBy(terms...);
+            return WindowDefinition<Name, Partition, decltype(newOrderBy)>{partitionBy, newOrderBy, frame};
+        }
+
+        auto Rows(const FrameBound &start, const FrameBound &end,
+                  FrameExclude exclude = FrameExclude::NO_OTHERS) const {
+            return WindowDefinition{partitionBy, orderBy, GetFrameSql(FrameUnit::ROWS, start, end, exclude)};
+        }
+
+        auto Range(const FrameBound &start, const FrameBound &end,
+                   FrameExclude exclude = FrameExclude::NO_OTHERS) const {
+            return WindowDefinition{partitionBy, orderBy, GetFrameSql(FrameUnit::RANGE, start, end, exclude)};
+        }
+
+        auto Groups(const FrameBound &start, const FrameBound &end,
+                    FrameExclude exclude = FrameExclude::NO_OTHERS) const {
+            return WindowDefinition{partitionBy, orderBy, GetFrameSql(FrameUnit::GROUPS, start, end, exclude)};
+        }
+    };
+
+    template<FixedString Name>
+    auto Window() {
+        return WindowDefinition<Name>{nullptr, nullptr, ""};
+    }
+
+    template<typename>
+    struct IsWindowDefinition : std::false_type {
+    };
+
+    template<FixedString Name, typename Partition, typename Order>
+    struct IsWindowDefinition<WindowDefinition<Name, Partition, Order> > : std::true_type {
+    };
+
+    template<typename T>
+    concept WindowDefinitionConcept = IsWindowDefinition<T>::value;
+
+    // SELECT 的 WINDOW 子句，位於 GROUP BY 之後、ORDER BY 之前
+    template<typename Windows>
+    std::string GetWindowsSql(const Windows &windows) {
+        if constexpr (std::is_null_pointer_v<Windows>) {
+            return "";
+        } else {
+            return std::apply([](const auto &... window) {
+                std::string sql = " WINDOW ";
+                bool first = true;
+                auto spec = [](const auto &w) {
+                    auto specSql = GetWindowSpecSql(w);
+                    return specSql.empty() ? specSql : specSql.substr(1);
+                };
+                ((sql += (first ? "" : ", ") + std::string(window.name) + " AS (" + spec(window) + ")",
+                  first = false), ...);
+                return sql;
+            }, windows);
+        }
+    }
+
+    // Over(w) 放在運算式欄位 tuple 中的標記，由 SELECT 檢查 WINDOW 子句是否定義了該視窗
+    template<FixedString Name>
+    struct WindowReference {
+        constexpr static FixedString name = Name;
+    };
+
+    template<typename>
+    struct IsWindowReference : std::false_type {
+    };
+
+    template<FixedString Name>
+    struct IsWindowReference<WindowReference<Name> > : std::true_type {
+    };
+
+    template<typename Windows, FixedString Name>
+    constexpr bool IsWindowDefined() {
+        if constexpr (std::is_null_pointer_v<Windows>) {
+            return false;
+        } else {
+            return []<typename... Ws>(std::tuple<Ws...> *) {
+                return ((std::string_view(Ws::name) == std::string_view(Name)) || ...);
+            }(static_cast<Windows *>(nullptr));
+        }
+    }
+
+    // 移除 WINDOW 子句已定義的視窗標記；剩下的標記代表缺少定義，執行語句時會編譯失敗
+    template<typename Windows, typename... Cols>
+    auto RemoveDefinedWindowReferences(const std::tuple<Cols...> &cols) {
+        return std::apply([](const auto &... col) {
+            return std::tuple_cat([&col] {
+                using Col = std::decay_t<decltype(col)>;
+                if constexpr (IsWindowReference<Col>::value) {
+                    if constexpr (IsWindowDefined<Windows, Col::name>()) {
+                        return std::tuple<>();
+                    } else {
+                        return std::make_tuple(col);
+                    }
+                } else {
+                    return std::make_tuple(col);
+                }
+            }()...);
+        }, cols);
+    }
+
+    template<typename>
+    struct HasWindowReference : std::false_type {
+    };
+
+    template<typename... Cols>
+    struct HasWindowReference<std::tuple<Cols...> > : std::bool_constant<(IsWindowReference<Cols>::value || ...)> {
+    };
+
+    template<typename Windows>
+    auto GetWindowsCols(const Windows &windows) {
+        if constexpr (std::is_null_pointer_v<Windows>) {
+            return std::tuple<>();
+        } else {
+            return std::apply([](const auto &... window) {
+                return std::tuple_cat(std::tuple_cat(GetExprsTupleColTuple(window.partitionBy),
+                                                     GetOrderByCols(window.orderBy))...);
+            }, windows);
+        }
+    }
+
+    template<typename Windows>
+    auto GetWindowsParams(const Windows &windows) {
+        if constexpr (std::is_null_pointer_v<Windows>) {
+            return std::tuple<>();
+        } else {
+            return std::apply([](const auto &... window) {
+                return std::tuple_cat(std::tuple_cat(GetExprsTupleParamTuple(window.partitionBy),
+                                                     GetOrderByParams(window.orderBy))...);
+            }, windows);
+        }
     }
 
-    //TODO frame_clause 未實作
     template<typename Columns, typename Parameters, typename Info>
     class WindowFunctions {
+        auto WithFrame(std::string frame) const {
+            auto _info = MakeInfo<returnType>(
+                info.windowFuncSql,
+                info.windowFuncCols,
+                info.windowFuncParams,
+                info.partitionBy,
+                info.orderBy,
+                std::move(frame)
+            );
+            return WindowFunctions{
+                .info = _info,
+                .cols = GetInfoCols(_info),
+                .params = GetInfoParams(_info),
+                .sql = GetSql(_info)
+            };
+        }
+
     public:
         using returnType = Info::returnType;
         const Info info;
@@ -91,8 +336,8 @@ namespace TypeSQLite {
                 info.windowFuncCols,
                 info.windowFuncParams,
                 std::make_tuple(exprs...),
-                info.orderExpr,
-                info.orderType
+                info.orderBy,
+                info.frame
             );
             auto newCols = GetInfoCols(_info);
             auto newParams = GetInfoParams(_info);
@@ -105,14 +350,20 @@ namespace TypeSQLite {
         }
 
         template<ExprOrColConcept Expr>
-        auto OrderBy(Expr expr, const OrderType order = OrderType::ASC) {
+        auto OrderBy(Expr expr, const OrderType order) {
+            return OrderBy(OrderingTerm<Expr>{expr, order});
+        }
+
+        template<OrderingTermOrExprConcept... Terms>
+        auto OrderBy(Terms... terms) {
+            static_assert(sizeof...(Terms) > 0, "OrderBy requires at least one ordering term");
             auto _info = MakeInfo<returnType>(
                 info.windowFuncSql,
                 info.windowFuncCols,
                 info.windowFuncParams,
                 info.partitionBy,
-                expr,
-                order
+                MakeOrderBy(terms...),
+                info.frame
             );
             auto newCols = GetInfoCols(_info);
             auto newParams = GetInfoParams(_info);
@@ -123,6 +374,45 @@ namespace TypeSQLite {
                 .sql = GetSql(_info)
             };
         }
+
+        auto Rows(const FrameBound &start, const FrameBound &end,
+                  FrameExclude exclude = FrameExclude::NO_OTHERS) const {
+            return WithFrame(GetFrameSql(FrameUnit::ROWS, start, end, exclude));
+        }
+
+        auto Range(const FrameBound &start, const FrameBound &end,
+                   FrameExclude exclude = FrameExclude::NO_OTHERS) const {
+            return WithFrame(GetFrameSql(FrameUnit::RANGE, start, end, exclude));
+        }
+
+        auto Groups(const FrameBound &start, const FrameBound &end,
+                    FrameExclude exclude = FrameExclude::NO_OTHERS) const {
+            return WithFrame(GetFrameSql(FrameUnit::GROUPS, start, end, exclude));
+        }
+
+        // 改用 SELECT 中 WINDOW 子句的具名視窗。已指定的 ORDER BY 與框架以 OVER (name ...) 延伸該視窗，
+        // SQLite 不允許延伸時加上 PARTITION BY、重複指定 ORDER BY，或延伸已有框架的視窗
+        template<WindowDefinitionConcept Window>
+        auto Over(const Window &window) const {
+            static_assert(std::is_null_pointer_v<decltype(info.partitionBy)>,
+                          "PARTITION BY must be part of the window definition when using a named window");
+            static_assert(std::is_null_pointer_v<decltype(info.orderBy)> ||
+                          std::is_null_pointer_v<decltype(window.orderBy)>,
+                          "The named window already has an ORDER BY");
+            auto spec = CreateSQLOrderBy(info) + info.frame;
+            if (!spec.empty() && !window.frame.empty()) {
+                throw std::logic_error("Cannot extend a named window that has a frame: " + std::string(Window::name));
+            }
+            auto newCols = std::tuple_cat(info.windowFuncCols, GetOrderByCols(info.orderBy),
+                                          std::tuple<WindowReference<Window::name> >());
+            auto newParams = std::tuple_cat(info.windowFuncParams, GetOrderByParams(info.orderBy));
+            return Expressions<returnType, decltype(newCols), decltype(newParams)>{
+                .cols = newCols,
+                .sql = info.windowFuncSql + " OVER " +
+                       (spec.empty() ? std::string(Window::name) : "(" + std::string(Window::name) + spec + ")"),
+                .params = newParams
+            };
+        }
     };
 
     template<typename>
@@ -145,7 +435,8 @@ namespace TypeSQLite {
             newCols,
             newPara,
             nullptr,
-            nullptr
+            nullptr,
+            ""
         );
         return WindowFunctions{
             .info = info,
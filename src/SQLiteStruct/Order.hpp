@@ -26,4 +26,23 @@ namespace TypeSQLite {
                 throw std::invalid_argument("Invalid OrderType");
         }
     }
-}
+
+    enum class NullsOrder {
+        DEFAULT,
+        FIRST,
+        LAST
+    };
+
+    inline std::string NullsOrderToString(NullsOrder nulls) {
+        switch (nulls) {
+            case NullsOrder::DEFAULT:
+                return "";
+            case NullsOrder::FIRST:
+                return " NULLS FIRST";
+            case NullsOrder::LAST:
+                return " NULLS LAST";
+            default:
+                throw std::invalid_argument("Invalid NullsOrder");
+        }
+    }
+}
\ No newline at end of file
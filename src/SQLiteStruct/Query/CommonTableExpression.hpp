@@ -0,0 +1,148 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "SelectAble.hpp"
+#include "../../TemplateHelper/FixedString.hpp"
+
+namespace TypeSQLite {
+    // name(c1, c2) AS (...)，以及其中 SELECT 的欄位與參數
+    template<typename Cols, typename Params>
+    struct CteDefinition {
+        std::string sql;
+        bool recursive;
+        Cols cols;
+        Params params;
+    };
+
+    // Definition 為 std::nullptr_t 時只是名稱的參照，供遞迴成員引用自己
+    template<FixedString Name, typename Cols, typename Definition>
+    class CommonTableExpression;
+
+    template<FixedString Name, typename Cols, typename Definition>
+    struct SourceWithDefinitions<CommonTableExpression<Name, Cols, Definition> > {
+        using type = std::conditional_t<std::is_null_pointer_v<Definition>, std::tuple<>, std::tuple<Definition> >;
+    };
+
+    // 未指定欄位時由結果欄位推導，結果欄位必須都是欄位
+    template<typename>
+    struct CteColumnImpl;
+
+    template<ColumnConcept Col>
+    struct CteColumnImpl<Col> {
+        using type = Col;
+    };
+
+    template<typename T, ColumnConcept Col>
+    struct CteColumnImpl<TableColumn_Base<T, Col> > {
+        using type = Col;
+    };
+
+    template<typename>
+    struct CteColumnsImpl;
+
+    template<typename... ResultCols>
+    struct CteColumnsImpl<std::tuple<ResultCols...> > {
+        using type = std::tuple<typename CteColumnImpl<ResultCols>::type...>;
+    };
+
+    template<SelectStatementConcept Statement, ColumnConcept... Cols>
+    auto GetCteColumns(Cols... cols) {
+        if constexpr (sizeof...(Cols) == 0) {
+            static_assert(IsAllColumns<typename Statement::ResultColumns>::value,
+                          "Result columns of the CTE must be columns, or the CTE columns must be given explicitly");
+            return typename CteColumnsImpl<typename Statement::ResultColumns>::type();
+        } else {
+            static_assert(sizeof...(Cols) == std::tuple_size_v<typename Statement::ResultColumns>,
+                          "CTE column count must match the result column count");
+            return std::make_tuple(cols...);
+        }
+    }
+
+    template<FixedString Name, typename Cols>
+    std::string GetCteHeaderSql(const Cols &columns) {
+        return std::apply([](auto... cols) {
+            std::string sql = std::string(Name) + "(";
+            ((sql += std::string(decltype(cols)::name) + ", "), ...);
+            sql.resize(sql.size() - 2);
+            return sql + ") AS ";
+        }, columns);
+    }
+
+    // WITH 的具名子查詢，可作為 Select/InnerJoin/LeftJoin 的來源。
+    // 使用它的語句會在最前面輸出 WITH 子句，參數也會排在最前面。
+    template<FixedString Name, typename Cols, typename Definition>
+    class CommonTableExpression final
+            : public SelectAble<Cols, SourceInfo<CommonTableExpression<Name, Cols, Definition> > > {
+        using Source = SourceInfo<CommonTableExpression>;
+
+        static auto MakeWith(const Definition &definition) {
+            if constexpr (std::is_null_pointer_v<Definition>) {
+                return std::tuple<>();
+            } else {
+                return std::make_tuple(definition);
+            }
+        }
+
+    public:
+        template<ColumnConcept Col>
+        using TableColumn = TableColumn_Base<CommonTableExpression, Col>;
+        constexpr static FixedString name = Name;
+
+        CommonTableExpression(SQLiteWrapper &sqlite, Cols columns, Definition definition)
+            : SelectAble<Cols, Source>(sqlite, columns, Source{.joins = {}, .with = MakeWith(definition)}) {
+        }
+
+        // 作為 Join 的來源時帶入的定義
+        auto WithDefinitions() const {
+            return this->_source.with;
+        }
+
+        template<typename Column>
+        auto operator[](Column column) const {
+            return TableColumn<Column>();
+        }
+    };
+
+    template<FixedString Name, SelectStatementConcept Statement, ColumnConcept... Cols>
+    auto MakeCommonTableExpression(SQLiteWrapper &sqlite, const Statement &statement, Cols... cols) {
+        auto columns = GetCteColumns<Statement>(cols...);
+        using Definition = CteDefinition<decltype(statement.cols), decltype(statement.params)>;
+        return CommonTableExpression<Name, decltype(columns), Definition>(sqlite, columns, Definition{
+                                                                                .sql = GetCteHeaderSql<Name>(columns)
+                                                                                       + "(" + statement.StatementSql()
+                                                                                       + ")",
+                                                                                .recursive = false,
+                                                                                .cols = statement.cols,
+                                                                                .params = statement.params
+                                                                            });
+    }
+
+    // anchor UNION ALL recursive(self)：recursive 以名稱參照 CTE 自己，回傳遞迴成員的 SELECT
+    template<FixedString Name, SelectStatementConcept Anchor, typename Recursive, ColumnConcept... Cols>
+    auto MakeRecursiveCommonTableExpression(SQLiteWrapper &sqlite, const Anchor &anchor, Recursive recursive,
+                                            Cols... cols) {
+        auto columns = GetCteColumns<Anchor>(cols...);
+        using ColTuple = decltype(columns);
+        const CommonTableExpression<Name, ColTuple, std::nullptr_t> self(sqlite, columns, nullptr);
+        auto member = recursive(self);
+        static_assert(SelectStatementConcept<decltype(member)>, "Recursive member must return a select statement");
+        static_assert(std::tuple_size_v<typename decltype(member)::ResultColumns> == std::tuple_size_v<ColTuple>,
+                      "Recursive member must return the same number of columns as the anchor");
+
+        auto defCols = std::tuple_cat(anchor.cols, member.cols);
+        auto defParams = std::tuple_cat(anchor.params, member.params);
+        using Definition = CteDefinition<decltype(defCols), decltype(defParams)>;
+        return CommonTableExpression<Name, ColTuple, Definition>(sqlite, columns, Definition{
+                                                                     .sql = GetCteHeaderSql<Name>(columns) + "("
+                                                                            + anchor.StatementSql() + " UNION ALL "
+                                                                            + member.StatementSql() + ")",
+                                                                     .recursive = true,
+                                                                     .cols = defCols,
+                                                                     .params = defParams
+                                                                 });
+    }
+}
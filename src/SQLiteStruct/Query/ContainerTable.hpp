@@ -0,0 +1,310 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "SelectAble.hpp"
+#include "../Expressions/UserFunctions.hpp"
+
+namespace TypeSQLite {
+    template<typename T>
+    concept TupleLikeConcept = requires { std::tuple_size<T>::value; };
+
+    // tuple 類的列依欄位順序取值，其餘型別視為單一欄位
+    template<size_t I, typename Row>
+    const auto &GetContainerElement(const Row &row) {
+        if constexpr (TupleLikeConcept<Row>) {
+            return std::get<I>(row);
+        } else {
+            return row;
+        }
+    }
+
+    template<typename Row, size_t I>
+    using ContainerElement = std::remove_cvref_t<decltype(GetContainerElement<I>(std::declval<const Row &>()))>;
+
+    // 等值查詢使用的雜湊鍵；void 代表該欄位不建立索引，只能全表掃描
+    template<typename T>
+    struct ContainerIndexKeyImpl {
+        using type = std::conditional_t<std::is_integral_v<T>, int64_t,
+            std::conditional_t<std::is_floating_point_v<T>, double, void> >;
+    };
+
+    template<>
+    struct ContainerIndexKeyImpl<std::string> {
+        using type = std::string_view;
+    };
+
+    template<>
+    struct ContainerIndexKeyImpl<std::string_view> {
+        using type = std::string_view;
+    };
+
+    template<typename T>
+    using ContainerIndexKey = typename ContainerIndexKeyImpl<T>::type;
+
+    template<typename Key>
+    struct ContainerIndexImpl {
+        using type = std::optional<std::unordered_multimap<Key, size_t> >;
+    };
+
+    template<>
+    struct ContainerIndexImpl<void> {
+        using type = std::monostate;
+    };
+
+    // 以執行期的欄位編號呼叫 f(std::integral_constant<size_t, I>)
+    template<size_t N, typename F>
+    void VisitContainerColumn(size_t column, F &&f) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((column == I ? (f(std::integral_constant<size_t, I>{}), true) : false) || ...);
+        }(std::make_index_sequence<N>{});
+    }
+
+    // 虛擬表模組的狀態：只保存資料的 span（不複製），索引在第一次等值查詢時建立
+    template<typename Row, size_t ColumnCount>
+    struct ContainerTableState {
+        using Indexes = decltype([]<size_t... I>(std::index_sequence<I...>) {
+            return std::tuple<typename ContainerIndexImpl<ContainerIndexKey<ContainerElement<Row, I> > >::type...>{};
+        }(std::make_index_sequence<ColumnCount>{}));
+
+        std::span<const Row> rows;
+        std::string schemaSql;
+        Indexes indexes{};
+
+        template<size_t I>
+        static constexpr bool IsIndexable() {
+            return !std::is_void_v<ContainerIndexKey<ContainerElement<Row, I> > >;
+        }
+
+        static bool IsIndexable(int column) {
+            bool indexable = false;
+            if (column >= 0) {
+                VisitContainerColumn<ColumnCount>(static_cast<size_t>(column), [&](auto I) {
+                    indexable = IsIndexable<I>();
+                });
+            }
+            return indexable;
+        }
+
+        template<size_t I>
+        const auto &GetIndex() {
+            auto &index = std::get<I>(indexes);
+            if (!index) {
+                index.emplace();
+                index->reserve(rows.size());
+                for (size_t i = 0; i < rows.size(); ++i) {
+                    index->emplace(ContainerIndexKey<ContainerElement<Row, I> >(GetContainerElement<I>(rows[i])), i);
+                }
+            }
+            return *index;
+        }
+
+        // 回傳欄位等於 pValue 的列號（遞增排序）
+        std::vector<size_t> FindEqual(size_t column, sqlite3_value *pValue) {
+            std::vector<size_t> matches;
+            if (sqlite3_value_type(pValue) == SQLITE_NULL) {
+                return matches;
+            }
+            VisitContainerColumn<ColumnCount>(column, [&](auto I) {
+                if constexpr (IsIndexable<I>()) {
+                    using Key = ContainerIndexKey<ContainerElement<Row, I> >;
+                    auto [begin, end] = GetIndex<I>().equal_range(ReadValue<Key>(pValue));
+                    for (auto it = begin; it != end; ++it) {
+                        matches.push_back(it->second);
+                    }
+                }
+            });
+            std::sort(matches.begin(), matches.end());
+            return matches;
+        }
+    };
+
+    template<typename Row, size_t ColumnCount>
+    struct ContainerModule {
+        using State = ContainerTableState<Row, ColumnCount>;
+
+        struct VTab : sqlite3_vtab {
+            State *pState;
+        };
+
+        struct Cursor : sqlite3_vtab_cursor {
+            // 全表掃描時 matches 為空，以 position 走訪所有列
+            std::optional<std::vector<size_t> > matches;
+            size_t position = 0;
+
+            size_t Current() const {
+                return matches ? (*matches)[position] : position;
+            }
+        };
+
+        static State &GetState(sqlite3_vtab_cursor *pCursor) {
+            return *static_cast<VTab *>(pCursor->pVtab)->pState;
+        }
+
+        static const sqlite3_module *Get() {
+            static const sqlite3_module module = [] {
+                sqlite3_module m{};
+                // 沒有 xCreate 代表只能以模組名稱直接使用（eponymous-only）
+                m.xConnect = [](sqlite3 *db, void *pAux, int, const char *const *, sqlite3_vtab **ppVtab,
+                                char **) {
+                    auto pState = static_cast<State *>(pAux);
+                    auto rc = sqlite3_declare_vtab(db, pState->schemaSql.c_str());
+                    if (rc != SQLITE_OK) {
+                        return rc;
+                    }
+                    auto pVtab = new VTab{};
+                    pVtab->pState = pState;
+                    *ppVtab = pVtab;
+                    return SQLITE_OK;
+                };
+                m.xBestIndex = [](sqlite3_vtab *pVtab, sqlite3_index_info *pInfo) {
+                    auto rowCount = static_cast<double>(static_cast<VTab *>(pVtab)->pState->rows.size());
+                    for (int i = 0; i < pInfo->nConstraint; ++i) {
+                        const auto &constraint = pInfo->aConstraint[i];
+                        if (constraint.usable && constraint.op == SQLITE_INDEX_CONSTRAINT_EQ &&
+                            State::IsIndexable(constraint.iColumn)) {
+                            // SQLite 仍會再比對一次，型別轉換規則與一般資料表相同
+                            pInfo->aConstraintUsage[i].argvIndex = 1;
+                            pInfo->idxNum = constraint.iColumn + 1;
+                            pInfo->estimatedCost = 10;
+                            pInfo->estimatedRows = 1;
+                            return SQLITE_OK;
+                        }
+                    }
+                    pInfo->idxNum = 0;
+                    pInfo->estimatedCost = rowCount + 1;
+                    pInfo->estimatedRows = static_cast<sqlite3_int64>(rowCount);
+                    return SQLITE_OK;
+                };
+                m.xDisconnect = [](sqlite3_vtab *pVtab) {
+                    delete static_cast<VTab *>(pVtab);
+                    return SQLITE_OK;
+                };
+                m.xDestroy = m.xDisconnect;
+                m.xOpen = [](sqlite3_vtab *, sqlite3_vtab_cursor **ppCursor) {
+                    *ppCursor = new Cursor{};
+                    return SQLITE_OK;
+                };
+                m.xClose = [](sqlite3_vtab_cursor *pCursor) {
+                    delete static_cast<Cursor *>(pCursor);
+                    return SQLITE_OK;
+                };
+                m.xFilter = [](sqlite3_vtab_cursor *pCursor, int idxNum, const char *, int, sqlite3_value **argv) {
+                    auto cursor = static_cast<Cursor *>(pCursor);
+                    cursor->position = 0;
+                    cursor->matches.reset();
+                    try {
+                        if (idxNum > 0) {
+                            cursor->matches = GetState(pCursor).FindEqual(static_cast<size_t>(idxNum - 1), argv[0]);
+                        }
+                    } catch (const std::bad_alloc &) {
+                        return SQLITE_NOMEM;
+                    }
+                    return SQLITE_OK;
+                };
+                m.xNext = [](sqlite3_vtab_cursor *pCursor) {
+                    ++static_cast<Cursor *>(pCursor)->position;
+                    return SQLITE_OK;
+                };
+                m.xEof = [](sqlite3_vtab_cursor *pCursor) {
+                    auto cursor = static_cast<Cursor *>(pCursor);
+                    auto size = cursor->matches ? cursor->matches->size() : GetState(pCursor).rows.size();
+                    return cursor->position >= size ? 1 : 0;
+                };
+                m.xColumn = [](sqlite3_vtab_cursor *pCursor, sqlite3_context *pContext, int column) {
+                    const auto &row = GetState(pCursor).rows[static_cast<Cursor *>(pCursor)->Current()];
+                    VisitContainerColumn<ColumnCount>(static_cast<size_t>(column), [&](auto I) {
+                        SetResult(pContext, GetContainerElement<I>(row));
+                    });
+                    return SQLITE_OK;
+                };
+                m.xRowid = [](sqlite3_vtab_cursor *pCursor, sqlite3_int64 *pRowId) {
+                    *pRowId = static_cast<sqlite3_int64>(static_cast<Cursor *>(pCursor)->Current());
+                    return SQLITE_OK;
+                };
+                return m;
+            }();
+            return &module;
+        }
+    };
+
+    // 將 C++ 容器以虛擬表的形式提供給 SQLite，可用於 InnerJoin/LeftJoin 與 In(col, table.Select(...))。
+    // 資料不會被複製：容器必須存活到最後一次查詢結束，且查詢執行期間不可修改。
+    // 物件必須先於 Database 解構。
+    template<FixedString Name, typename Row, typename Cols>
+    class ContainerTable final : public SelectAble<Cols, SourceInfo<ContainerTable<Name, Row, Cols> > > {
+        static constexpr size_t ColumnCount = std::tuple_size_v<Cols>;
+        using Module = ContainerModule<Row, ColumnCount>;
+
+        sqlite3 *_db;
+        typename Module::State *_pState;
+
+        static std::string GetSchemaSql(const Cols &columns) {
+            return std::apply([](auto... cols) {
+                std::string sql = "CREATE TABLE x(";
+                ((sql += std::string(decltype(cols)::name) + " " + DataTypeToString<decltype(cols)::type>() + ","),
+                    ...);
+                sql.back() = ')';
+                return sql;
+            }, columns);
+        }
+
+    public:
+        template<ColumnConcept Col>
+        using TableColumn = TableColumn_Base<ContainerTable, Col>;
+        constexpr static FixedString name = Name;
+
+        ContainerTable(SQLiteWrapper &sqlite, std::span<const Row> rows, Cols columns)
+            : SelectAble<Cols, SourceInfo<ContainerTable> >(sqlite, columns, SourceInfo<ContainerTable>()),
+              _db(sqlite._dbPtr.get()), _pState(new typename Module::State{rows, GetSchemaSql(columns)}) {
+            if constexpr (TupleLikeConcept<Row>) {
+                static_assert(std::tuple_size_v<Row> == ColumnCount, "Column count must match the row tuple size");
+            } else {
+                static_assert(ColumnCount == 1, "Scalar rows expose exactly one column");
+            }
+            auto rc = sqlite3_create_module_v2(_db, Name.value, Module::Get(), _pState, [](void *pState) {
+                delete static_cast<typename Module::State *>(pState);
+            });
+            if (rc != SQLITE_OK) {
+                throw std::runtime_error("Failed to register container table " + std::string(Name.value) + ": " +
+                                         std::string(sqlite3_errmsg(_db)));
+            }
+        }
+
+        ContainerTable(const ContainerTable &) = delete;
+
+        ContainerTable &operator=(const ContainerTable &) = delete;
+
+        // 以 NULL 模組重新註冊即移除模組，SQLite 會釋放狀態
+        ~ContainerTable() override {
+            sqlite3_create_module_v2(_db, Name.value, nullptr, nullptr, nullptr);
+        }
+
+        // 換成另一份資料，不可在查詢執行期間呼叫
+        void Bind(std::span<const Row> rows) {
+            _pState->rows = rows;
+            _pState->indexes = {};
+            this->_sqlite.ClearQueryCache();
+        }
+
+        size_t Size() const {
+            return _pState->rows.size();
+        }
+
+        template<typename Column>
+        auto operator[](Column column) {
+            return TableColumn<Column>();
+        }
+    };
+}
@@ -53,12 +53,33 @@ namespace TypeSQLite {
         Cond condition;
     };
 
+    // 來源帶有的 CTE 定義，預設沒有；CommonTableExpression 會特化
+    template<typename Src>
+    struct SourceWithDefinitions {
+        using type = std::tuple<>;
+    };
+
+    template<typename... Srcs>
+    using WithDefinitionsTuple = decltype(std::tuple_cat(
+        std::declval<typename SourceWithDefinitions<Srcs>::type>()...));
+
     template<typename MainSrc, typename... JoinSrcs>
     struct SourceInfo {
         using Source = MainSrc;
         std::tuple<JoinSrcs...> joins;
+        // 依來源出現的順序輸出為 WITH 子句
+        WithDefinitionsTuple<MainSrc, typename JoinSrcs::Source...> with;
     };
 
+    template<typename Src>
+    auto GetSourceWithDefinitions(const Src &src) {
+        if constexpr (requires { src.WithDefinitions(); }) {
+            return src.WithDefinitions();
+        } else {
+            return std::tuple<>();
+        }
+    }
+
     template<typename>
     struct IsSourceInfo : std::false_type {
     };
@@ -70,14 +91,50 @@ namespace TypeSQLite {
     template<typename T>
     concept SourceInfoConcept = IsSourceInfo<T>::value;
 
-    template<typename MainSrc, typename... JoinSrcs, typename NewJoin>
-    auto JoinSource(SourceInfo<MainSrc, JoinSrcs...> src, NewJoin join) {
+    template<typename MainSrc, typename... JoinSrcs, typename NewJoin, typename NewWith>
+    auto JoinSource(SourceInfo<MainSrc, JoinSrcs...> src, NewJoin join, NewWith with) {
         using NewType = SourceInfo<MainSrc, JoinSrcs..., NewJoin>;
         return NewType{
-            .joins = std::tuple_cat(src.joins, std::make_tuple(std::move(join)))
+            .joins = std::tuple_cat(src.joins, std::make_tuple(std::move(join))),
+            .with = std::tuple_cat(src.with, std::move(with))
         };
     }
 
+    // WITH [RECURSIVE] a(...) AS (...), b(...) AS (...)，沒有 CTE 時為空字串
+    template<typename... Definitions>
+    std::string MakeWithSQL(const std::tuple<Definitions...> &with) {
+        return std::apply([](const auto &... definitions) {
+            if constexpr (sizeof...(definitions) == 0) {
+                return std::string();
+            } else {
+                std::string sql = (definitions.recursive || ...) ? "WITH RECURSIVE " : "WITH ";
+                bool first = true;
+                ((sql += (first ? "" : ", ") + definitions.sql, first = false), ...);
+                return sql + " ";
+            }
+        }, with);
+    }
+
+    template<typename MainSrc, typename... Joins>
+    std::string MakeWithSQL(const SourceInfo<MainSrc, Joins...> &src) {
+        return MakeWithSQL(src.with);
+    }
+
+    // WITH 子句在語句最前面，參數也必須排在最前面
+    template<typename MainSrc, typename... Joins>
+    auto GetExtractWithParams(const SourceInfo<MainSrc, Joins...> &src) {
+        return std::apply([](const auto &... definitions) {
+            return std::tuple_cat(definitions.params...);
+        }, src.with);
+    }
+
+    template<typename MainSrc, typename... Joins>
+    auto GetExtractWithCols(const SourceInfo<MainSrc, Joins...> &src) {
+        return std::apply([](const auto &... definitions) {
+            return std::tuple_cat(definitions.cols...);
+        }, src.with);
+    }
+
     template<typename MainSrc, typename... Joins>
     std::string MakeSourceSQL(const SourceInfo<MainSrc, Joins...> &src) {
         std::string sql = std::string(MainSrc::name);
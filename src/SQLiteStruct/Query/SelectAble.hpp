@@ -5,6 +5,8 @@
 #include "../Query/DataSource.hpp"
 #include "../Column/Column.hpp"
 #include "../Expressions/Expressions.hpp"
+#include "../Expressions/OrderingTerm.hpp"
+#include "../Expressions/WindowFunctions.hpp"
 
 namespace TypeSQLite {
     template<typename Cols, SourceInfoConcept Src>
@@ -51,15 +53,18 @@ namespace TypeSQLite {
         typename Source,
         typename Where,
         typename GroupBy,
-        typename OrderExpr,
+        typename Windows,
+        typename OrderBy,
         typename... ResultColumns>
     struct SelectStatementInfo {
         Source source;
         Where where;
         GroupBy groupBy;
-        OrderExpr orderExpr;
+        // WindowDefinition 的 tuple，沒有 WINDOW 子句時為 nullptr
+        Windows windows;
+        // OrderingTerm 的 tuple，未排序時為 nullptr
+        OrderBy orderBy;
         std::tuple<ResultColumns...> resultColumns;
-        OrderType orderType = OrderType::ASC;
         //TODO 支援express limit offset
         std::optional<std::pair<int, int> > limitOffset;
         bool isDistinct;
@@ -69,33 +74,45 @@ namespace TypeSQLite {
         typename Source,
         typename Where,
         typename GroupBy,
-        typename OrderExpr,
+        typename Windows,
+        typename OrderBy,
         typename... ResultColumns>
     auto MakeSelectStatementInfo(
         Source source,
         Where where,
         GroupBy groupBy,
-        OrderExpr orderExpr,
-        OrderType orderType,
+        Windows windows,
+        OrderBy orderBy,
         const std::optional<std::pair<int, int> > &limitOffset,
         bool isDistinct,
         ResultColumns... columns
     ) {
-        return SelectStatementInfo<Source, Where, GroupBy, OrderExpr, ResultColumns...>{
+        return SelectStatementInfo<Source, Where, GroupBy, Windows, OrderBy, ResultColumns...>{
             .source = source,
             .where = where,
             .groupBy = groupBy,
-            .orderExpr = orderExpr,
+            .windows = windows,
+            .orderBy = orderBy,
             .resultColumns = std::make_tuple(columns...),
-            .orderType = orderType,
             .limitOffset = limitOffset,
             .isDistinct = isDistinct
         };
     }
 
+    inline std::string GetLimitOffsetSql(const std::optional<std::pair<int, int> > &limitOffset) {
+        if (!limitOffset.has_value()) {
+            return "";
+        }
+        auto sql = " LIMIT " + std::to_string(limitOffset->first);
+        if (limitOffset->second > 0) {
+            sql += " OFFSET " + std::to_string(limitOffset->second);
+        }
+        return sql;
+    }
+
     template<typename Info>
     std::string GetInfoSql(const Info &info) {
-        auto sql = std::string("SELECT ") + (info.isDistinct ? "DISTINCT " : "") +
+        auto sql = MakeWithSQL(info.source) + "SELECT " + (info.isDistinct ? "DISTINCT " : "") +
                    std::apply([](auto &&... results) { return GetExprSqls(results...); }, info.resultColumns)
                    + " FROM "
                    + MakeSourceSQL(info.source);
@@ -105,40 +122,338 @@ namespace TypeSQLite {
         if constexpr (!std::is_null_pointer_v<decltype(info.groupBy)>) {
             sql += " GROUP BY " + std::apply([](auto &&... expr) { return GetExprSqls(expr...); }, info.groupBy);
         }
-        if constexpr (!std::is_null_pointer_v<decltype(info.orderExpr)>) {
-            sql += " ORDER BY " + info.orderExpr.sql + " " + OrderTypeToString(info.orderType);
-        }
-        if (info.limitOffset.has_value()) {
-            sql += " LIMIT " + std::to_string(info.limitOffset->first);
-            if (info.limitOffset->second > 0) {
-                sql += " OFFSET " + std::to_string(info.limitOffset->second);
-            }
-        }
+        sql += GetWindowsSql(info.windows);
+        sql += GetOrderBySql(info.orderBy);
+        sql += GetLimitOffsetSql(info.limitOffset);
         return sql;
     };
 
     template<typename Info>
     auto GetSelectInfoCols(const Info &info) {
-        return std::tuple_cat(
+        return RemoveDefinedWindowReferences<decltype(info.windows)>(std::tuple_cat(
+            GetExtractWithCols(info.source),
             GetExprsTupleColTuple(info.resultColumns),
             GetExtractSourceCols(info.source),
             GetExprsColTuple(info.where),
             GetExprsTupleColTuple(info.groupBy),
-            GetExprsColTuple(info.orderExpr)
-        );
+            GetWindowsCols(info.windows),
+            GetOrderByCols(info.orderBy)
+        ));
     };
 
     template<typename Info>
     auto GetSelectInfoParams(const Info &info) {
         return std::tuple_cat(
+            GetExtractWithParams(info.source),
             GetExprsTupleParamTuple(info.resultColumns),
             GetExtractSourceParams(info.source),
             GetExprsParamTuple(info.where),
             GetExprsTupleParamTuple(info.groupBy),
-            GetExprsParamTuple(info.orderExpr)
+            GetWindowsParams(info.windows),
+            GetOrderByParams(info.orderBy)
         );
     };
 
+    template<typename>
+    struct IsAllColumns : std::false_type {
+    };
+
+    template<typename ... Cols>
+    struct IsAllColumns<std::tuple<Cols...> > : std::bool_constant<(ColumnOrTableColumnConcept<Cols> && ...)> {
+    };
+
+    template<typename>
+    struct RowTypeImpl;
+
+    template<typename ... Cols>
+    struct RowTypeImpl<std::tuple<Cols...> > {
+        using type = std::tuple<ExprOrColReturnType<Cols>...>;
+    };
+
+    template<typename Cols>
+    using RowType = typename RowTypeImpl<Cols>::type;
+
+    // Keyset 分頁游標：保存上一頁最後一列的排序鍵值，只能由 Paginator 產生並傳回
+    template<typename... KeyTypes>
+    class PageCursor {
+        template<typename Cols, SourceInfoConcept Src>
+        friend class SelectAble;
+
+        using KeyTuple = std::tuple<KeyTypes...>;
+
+        KeyTuple _keys;
+
+        explicit PageCursor(KeyTuple keys) : _keys(std::move(keys)) {
+        }
+
+        const KeyTuple &Keys() const {
+            return _keys;
+        }
+    };
+
+    template<typename>
+    struct PageCursorImpl;
+
+    template<typename ... Keys>
+    struct PageCursorImpl<std::tuple<Keys...> > {
+        using type = PageCursor<ExprOrColReturnType<Keys>...>;
+    };
+
+    template<typename Keys>
+    using PageCursorOf = typename PageCursorImpl<Keys>::type;
+
+    template<typename Row, typename Cursor>
+    struct Page {
+        std::vector<Row> rows;
+        // 沒有下一頁時為 std::nullopt
+        std::optional<Cursor> next;
+    };
+
+    template<ColumnOrTableColumnConcept Key, ColumnOrTableColumnConcept... Keys>
+    std::string GetKeysetSql(const Key &key, const Keys &... keys) {
+        if constexpr (sizeof...(Keys) == 0) {
+            return key.sql;
+        } else {
+            return key.sql + ", " + GetKeysetSql(keys...);
+        }
+    }
+
+    enum class CompoundOperator {
+        UNION,
+        UNION_ALL,
+        INTERSECT,
+        EXCEPT
+    };
+
+    inline const char *GetCompoundOperatorString(CompoundOperator op) {
+        switch (op) {
+            case CompoundOperator::UNION:
+                return " UNION ";
+            case CompoundOperator::UNION_ALL:
+                return " UNION ALL ";
+            case CompoundOperator::INTERSECT:
+                return " INTERSECT ";
+            case CompoundOperator::EXCEPT:
+                return " EXCEPT ";
+            default:
+                throw std::runtime_error("Unsupported compound operator");
+        }
+    }
+
+    // 各個 SELECT 與運算子組成的 sql，ORDER BY/LIMIT 套用在整個複合查詢
+    template<typename RCols, typename Cols, typename Params, typename OrderBy>
+    struct CompoundSelectInfo {
+        using ResultColumns = RCols;
+        std::string sql;
+        Cols cols;
+        Params params;
+        OrderBy orderBy;
+        std::optional<std::pair<int, int> > limitOffset;
+    };
+
+    template<typename ResultColumns, typename Cols, typename Params, typename OrderBy>
+    auto MakeCompoundSelectInfo(std::string sql, Cols cols, Params params, OrderBy orderBy,
+                                const std::optional<std::pair<int, int> > &limitOffset) {
+        return CompoundSelectInfo<ResultColumns, Cols, Params, OrderBy>{
+            .sql = std::move(sql),
+            .cols = cols,
+            .params = params,
+            .orderBy = orderBy,
+            .limitOffset = limitOffset
+        };
+    }
+
+    template<typename ResultColumns, typename Cols, typename Params, typename OrderBy>
+    std::string GetInfoSql(const CompoundSelectInfo<ResultColumns, Cols, Params, OrderBy> &info) {
+        return info.sql + GetOrderBySql(info.orderBy) + GetLimitOffsetSql(info.limitOffset);
+    }
+
+    template<typename ResultColumns, typename Cols, typename Params, typename OrderBy>
+    auto GetSelectInfoCols(const CompoundSelectInfo<ResultColumns, Cols, Params, OrderBy> &info) {
+        return std::tuple_cat(info.cols, GetOrderByCols(info.orderBy));
+    }
+
+    template<typename ResultColumns, typename Cols, typename Params, typename OrderBy>
+    auto GetSelectInfoParams(const CompoundSelectInfo<ResultColumns, Cols, Params, OrderBy> &info) {
+        return std::tuple_cat(info.params, GetOrderByParams(info.orderBy));
+    }
+
+    template<typename Row, typename Other>
+    constexpr void CheckCompoundOperand() {
+        static_assert(SelectStatementConcept<Other>, "Compound select operand must be a select statement");
+        static_assert(std::is_same_v<Row, typename Other::Row>,
+                      "Compound select operands must return the same column types");
+    }
+
+    template<typename Info>
+    class CompoundSelectStatement;
+
+    // SelectStatement 與 CompoundSelectStatement 共用的執行與複合運算。
+    // Derived 需提供 _sqlite、_info、StatementSql() 與 CompoundOperandSql()
+    template<typename Derived>
+    class SelectStatementOperations {
+        const Derived &Self() const {
+            return static_cast<const Derived &>(*this);
+        }
+
+        template<bool Cached, typename... Results>
+        auto Query(std::tuple<Results...> *) const {
+            const auto &self = Self();
+            return std::apply([&self](auto... params) {
+                if constexpr (Cached) {
+                    return self._sqlite.template CachedQuery<ExprOrColReturnType<Results>...>(
+                        self.StatementSql() + ";", params...);
+                } else {
+                    return self._sqlite.template Query<ExprOrColReturnType<Results>...>(
+                        self.StatementSql() + ";", params...);
+                }
+            }, self.params);
+        }
+
+    protected:
+        template<typename T, typename Params>
+        T QueryScalar(const std::string &sql, const Params &params) const {
+            auto result = std::apply([this, &sql](auto... ps) {
+                return Self()._sqlite.template Query<T>(sql, ps...);
+            }, params);
+            return std::get<0>(*result.begin());
+        }
+
+        int64_t CountSubQuery() const {
+            return QueryScalar<int64_t>("SELECT COUNT(*) FROM (" + Self().StatementSql() + ");", Self().params);
+        }
+
+    public:
+        // 與另一個結果欄位型別相同的 SELECT 組成複合查詢，運算子由左至右結合
+        template<typename Other>
+        auto Compound(CompoundOperator op, const Other &other) const {
+            const auto &self = Self();
+            CheckCompoundOperand<typename Derived::Row, Other>();
+            auto info = MakeCompoundSelectInfo<typename Derived::ResultColumns>(
+                self.CompoundOperandSql(true) + GetCompoundOperatorString(op) + other.CompoundOperandSql(false),
+                std::tuple_cat(self.cols, other.cols),
+                std::tuple_cat(self.params, other.params),
+                nullptr,
+                std::nullopt
+            );
+            return CompoundSelectStatement<decltype(info)>(self._sqlite, info);
+        }
+
+        template<typename Other>
+        auto Union(const Other &other) const {
+            return Compound(CompoundOperator::UNION, other);
+        }
+
+        template<typename Other>
+        auto UnionAll(const Other &other) const {
+            return Compound(CompoundOperator::UNION_ALL, other);
+        }
+
+        template<typename Other>
+        auto Intersect(const Other &other) const {
+            return Compound(CompoundOperator::INTERSECT, other);
+        }
+
+        template<typename Other>
+        auto Except(const Other &other) const {
+            return Compound(CompoundOperator::EXCEPT, other);
+        }
+
+        // SELECT EXISTS(... LIMIT 1)，找到第一列即停止
+        bool Exists() const {
+            auto sql = Self().StatementSql();
+            if (!Self()._info.limitOffset.has_value()) {
+                sql += " LIMIT 1";
+            }
+            return QueryScalar<int>("SELECT EXISTS(" + sql + ");", Self().params) != 0;
+        }
+
+        auto Results() const {
+            return Query<false>(static_cast<typename Derived::ResultColumns *>(nullptr));
+        }
+
+        // 實體化結果；Database 啟用查詢快取時相同的 SQL 與參數會共用同一份結果
+        auto CachedResults() const {
+            return Query<true>(static_cast<typename Derived::ResultColumns *>(nullptr));
+        }
+    };
+
+    // UNION/UNION ALL/INTERSECT/EXCEPT，由 SQLite 合併與去除重複，只傳回最終的資料列。
+    // 排序與筆數限制套用在整個複合查詢；帶 ORDER BY/LIMIT/WITH 的運算元會包成子查詢。
+    template<typename Info>
+    class [[nodiscard("You must call Result() for the query to run.")]]
+            CompoundSelectStatement
+            : public Expressions<
+                ReturnTypes<typename Info::ResultColumns>,
+                decltype(GetSelectInfoCols(std::declval<Info>())),
+                decltype(GetSelectInfoParams(std::declval<Info>()))
+            >,
+              public SelectStatementOperations<CompoundSelectStatement<Info> > {
+        friend class SelectStatementOperations<CompoundSelectStatement>;
+
+        const SQLiteWrapper &_sqlite;
+        Info _info;
+
+    public:
+        using Row = RowType<typename Info::ResultColumns>;
+        using ResultColumns = typename Info::ResultColumns;
+
+        explicit CompoundSelectStatement(const SQLiteWrapper &sqlite, Info info)
+            : Expressions<
+                  ReturnTypes<typename Info::ResultColumns>,
+                  decltype(GetSelectInfoCols(std::declval<Info>())),
+                  decltype(GetSelectInfoParams(std::declval<Info>()))
+              >{
+                  .cols = GetSelectInfoCols(info),
+                  .sql = "(" + GetInfoSql(info) + ")",
+                  .params = GetSelectInfoParams(info)
+              },
+              _sqlite(sqlite),
+              _info(info) {
+        }
+
+        std::string StatementSql() const {
+            return GetInfoSql(_info);
+        }
+
+        // 作為左邊的運算元且沒有 ORDER BY/LIMIT 時直接接續；否則包成子查詢，保留原本的結合順序
+        std::string CompoundOperandSql(bool leftmost) const {
+            if (leftmost && std::is_null_pointer_v<decltype(_info.orderBy)> && !_info.limitOffset.has_value()) {
+                return StatementSql();
+            }
+            return "SELECT * FROM (" + StatementSql() + ")";
+        }
+
+        template<ExprOrColConcept Expr>
+        auto OrderBy(Expr expr, OrderType order) const {
+            return OrderBy(OrderingTerm<Expr>{expr, order});
+        }
+
+        // 排序鍵必須對應最左邊 SELECT 的結果欄位；最左邊的運算元被包成子查詢時，
+        // 結果欄位不再帶資料表名稱，須以未限定的欄位（如 NameColumn）排序
+        template<OrderingTermOrExprConcept... Terms>
+        auto OrderBy(Terms... terms) const {
+            static_assert(sizeof...(Terms) > 0, "OrderBy requires at least one ordering term");
+            auto info = MakeCompoundSelectInfo<ResultColumns>(
+                _info.sql,
+                _info.cols,
+                _info.params,
+                MakeOrderBy(terms...),
+                _info.limitOffset
+            );
+            return CompoundSelectStatement<decltype(info)>(_sqlite, info);
+        }
+
+        CompoundSelectStatement &LimitOffset(int limit, int offset = 0) {
+            _info.limitOffset = std::make_pair(limit, offset);
+            return *this;
+        }
+
+        int64_t Count() const {
+            return this->CountSubQuery();
+        }
+    };
+
     template<typename Cols, SourceInfoConcept Source>
     class SelectAble {
     public:
@@ -148,14 +463,119 @@ namespace TypeSQLite {
         SQLiteWrapper &_sqlite;
         const Source _source;
 
-        template<typename Info>
+        // 以 WHERE (k1, k2) > (?, ?) ORDER BY k1, k2 LIMIT n 取代 OFFSET，
+        // 每頁的成本只與頁大小有關，而不是與頁碼有關。
+        // Keys 必須包含唯一的 tiebreaker，否則相同鍵值的列可能被跳過；
+        // Keys 必須是 NOT NULL 欄位，否則 (k1, k2) > (?, ?) 遇到 NULL 時為 NULL，分頁會提早結束。
+        template<typename Info, typename Keys>
+        class Paginator {
+        public:
+            using Row = RowType<decltype(std::declval<Info>().resultColumns)>;
+            using Cursor = PageCursorOf<Keys>;
+
+        private:
+            using SeekExpr = Expressions<double, Keys, typename Cursor::KeyTuple>;
+
+            const SQLiteWrapper &_sqlite;
+            Info _info;
+            Keys _keys;
+            int _pageSize;
+            OrderType _order;
+
+            template<typename Row, size_t... RowIdx, size_t... KeyIdx>
+            static auto SplitRow(Row &&row, std::index_sequence<RowIdx...>, std::index_sequence<KeyIdx...>) {
+                constexpr auto rowSize = sizeof...(RowIdx);
+                return std::make_pair(
+                    std::make_tuple(std::get<RowIdx>(std::move(row))...),
+                    std::make_tuple(std::get<rowSize + KeyIdx>(std::move(row))...)
+                );
+            }
+
+            template<typename Where>
+            auto Fetch(const Where &where) const {
+                auto orderBy = std::apply([this](auto... keys) {
+                    return MakeOrderBy(OrderingTerm<decltype(keys)>{keys, _order}...);
+                }, _keys);
+                auto info = std::apply([&](auto... results) {
+                    return std::apply([&](auto... keys) {
+                        return MakeSelectStatementInfo(
+                            _info.source,
+                            where,
+                            _info.groupBy,
+                            _info.windows,
+                            orderBy,
+                            std::make_optional(std::make_pair(_pageSize + 1, 0)),
+                            _info.isDistinct,
+                            results...,
+                            keys...
+                        );
+                    }, _keys);
+                }, _info.resultColumns);
+                // 多取一列用來判斷是否還有下一頁
+                auto rows = SelectStatement<decltype(info)>(_sqlite, info).Results().ToVector();
+
+                Page<Row, Cursor> page;
+                std::optional<typename Cursor::KeyTuple> lastKeys;
+                for (auto &row: rows) {
+                    if (page.rows.size() == static_cast<size_t>(_pageSize)) {
+                        page.next = Cursor(std::move(*lastKeys));
+                        break;
+                    }
+                    auto [data, keys] = SplitRow(
+                        std::move(row),
+                        std::make_index_sequence<std::tuple_size_v<Row> >(),
+                        std::make_index_sequence<std::tuple_size_v<Keys> >()
+                    );
+                    page.rows.push_back(std::move(data));
+                    lastKeys = std::move(keys);
+                }
+                return page;
+            }
+
+        public:
+            explicit Paginator(const SQLiteWrapper &sqlite, Info info, Keys keys, int pageSize,
+                               OrderType order)
+                : _sqlite(sqlite), _info(info), _keys(keys), _pageSize(pageSize), _order(order) {
+                if (pageSize <= 0) {
+                    throw std::invalid_argument("Page size must be positive");
+                }
+            }
+
+            // 取得游標之後的一頁；不帶游標時取第一頁
+            Page<Row, Cursor> FetchPage(const std::optional<Cursor> &after = std::nullopt) const {
+                if (!after.has_value()) {
+                    return Fetch(_info.where);
+                }
+                std::string placeholders = "?";
+                for (size_t i = 1; i < std::tuple_size_v<Keys>; ++i) {
+                    placeholders += ", ?";
+                }
+                auto keysSql = std::apply([](auto... keys) { return GetKeysetSql(keys...); }, _keys);
+                SeekExpr seek{
+                    _keys,
+                    "(" + keysSql + ")" + (_order == OrderType::ASC ? " > " : " < ") + "(" + placeholders + ")",
+                    after->Keys()
+                };
+                if constexpr (std::is_null_pointer_v<decltype(_info.where)>) {
+                    return Fetch(seek);
+                } else {
+                    return Fetch(_info.where && seek);
+                }
+            }
+        };
+
+        // IsDistinct 與 Info 中的 isDistinct 相同，讓 Paginate 可以在編譯期拒絕 DISTINCT
+        template<typename Info, bool IsDistinct = false>
         class [[nodiscard("You must call Result() for the query to run.")]]
                 SelectStatement
                 : public Expressions<
                     ReturnTypes<decltype(std::declval<Info>().resultColumns)>,
                     decltype(GetSelectInfoCols(std::declval<Info>())),
                     decltype(GetSelectInfoParams(std::declval<Info>()))
-                > {
+                >,
+                  public SelectStatementOperations<SelectStatement<Info, IsDistinct> > {
+            friend class SelectStatementOperations<SelectStatement>;
+
             const SQLiteWrapper &_sqlite;
             Info _info;
 
@@ -174,6 +594,25 @@ namespace TypeSQLite {
                   _info(info) {
             }
 
+            using Row = RowType<decltype(std::declval<Info>().resultColumns)>;
+            using ResultColumns = decltype(std::declval<Info>().resultColumns);
+
+            // 不含外層括號的 SELECT 語句，供 INSERT ... SELECT 等語句嵌入
+            std::string StatementSql() const {
+                static_assert(!HasWindowReference<std::remove_const_t<decltype(this->cols)> >::value,
+                              "Over(window) refers to a window that is not added with Select(...).Window(...)");
+                return GetInfoSql(_info);
+            }
+
+            // ORDER BY/LIMIT/WITH 不能直接出現在複合查詢的運算元中，這時包成子查詢
+            std::string CompoundOperandSql(bool) const {
+                if (std::is_null_pointer_v<decltype(_info.orderBy)> &&
+                    std::tuple_size_v<decltype(_info.source.with)> == 0 && !_info.limitOffset.has_value()) {
+                    return StatementSql();
+                }
+                return "SELECT * FROM (" + StatementSql() + ")";
+            }
+
             template<ExprOrColConcept Expr>
             auto Where(const Expr &expr) {
                 auto info = std::apply([this,&expr](auto... results) {
@@ -181,14 +620,14 @@ namespace TypeSQLite {
                         _info.source,
                         expr,
                         _info.groupBy,
-                        _info.orderExpr,
-                        _info.orderType,
+                        _info.windows,
+                        _info.orderBy,
                         _info.limitOffset,
                         _info.isDistinct,
                         results...
                     );
                 }, _info.resultColumns);
-                return SelectStatement<decltype(info)>(_sqlite, info);
+                return SelectStatement<decltype(info), IsDistinct>(_sqlite, info);
             }
 
             SelectStatement &LimitOffset(int limit, int offset = 0) {
@@ -196,9 +635,10 @@ namespace TypeSQLite {
                 return *this;
             }
 
-            SelectStatement &Distinct() {
-                _info.isDistinct = true;
-                return *this;
+            auto Distinct() const {
+                auto info = _info;
+                info.isDistinct = true;
+                return SelectStatement<Info, true>(_sqlite, info);
             }
 
             template<ExprOrColConcept... Exprs>
@@ -208,43 +648,95 @@ namespace TypeSQLite {
                         _info.source,
                         _info.where,
                         std::make_tuple(exprs...),
-                        _info.orderExpr,
-                        _info.orderType,
+                        _info.windows,
+                        _info.orderBy,
                         _info.limitOffset,
                         _info.isDistinct,
                         results...
                     );
                 }, _info.resultColumns);
-                return SelectStatement<decltype(info)>(_sqlite, info);
+                return SelectStatement<decltype(info), IsDistinct>(_sqlite, info);
+            }
+
+            // WINDOW 子句，供結果欄位中的視窗函式以 Over(w) 共用
+            template<WindowDefinitionConcept... Windows>
+            auto Window(Windows... windows) {
+                static_assert(sizeof...(Windows) > 0, "Window requires at least one window definition");
+                auto info = std::apply([this,&windows...](auto... results) {
+                    return MakeSelectStatementInfo(
+                        _info.source,
+                        _info.where,
+                        _info.groupBy,
+                        std::make_tuple(windows...),
+                        _info.orderBy,
+                        _info.limitOffset,
+                        _info.isDistinct,
+                        results...
+                    );
+                }, _info.resultColumns);
+                return SelectStatement<decltype(info), IsDistinct>(_sqlite, info);
             }
 
             template<ExprOrColConcept Expr>
-            auto OrderBy(Expr expr, OrderType order = OrderType::ASC) {
-                auto info = std::apply([this,&expr,&order](auto... results) {
+            auto OrderBy(Expr expr, OrderType order) {
+                return OrderBy(OrderingTerm<Expr>{expr, order});
+            }
+
+            // 多鍵排序，可與複合索引的欄位順序對應，避免額外的 TEMP B-TREE 排序
+            template<OrderingTermOrExprConcept... Terms>
+            auto OrderBy(Terms... terms) {
+                static_assert(sizeof...(Terms) > 0, "OrderBy requires at least one ordering term");
+                auto info = std::apply([this,&terms...](auto... results) {
                     return MakeSelectStatementInfo(
                         _info.source,
                         _info.where,
                         _info.groupBy,
-                        expr,
-                        order,
+                        _info.windows,
+                        MakeOrderBy(terms...),
                         _info.limitOffset,
                         _info.isDistinct,
                         results...
                     );
                 }, _info.resultColumns);
-                return SelectStatement<decltype(info)>(_sqlite, info);
+                return SelectStatement<decltype(info), IsDistinct>(_sqlite, info);
             }
 
-            auto Results() {
-                return std::apply([this](auto... params) {
-                    return std::apply([this,&params...](auto... results) {
-                        return _sqlite.Query<ExprOrColReturnType<decltype(results)>
-                            ...>(GetInfoSql(_info) + ";", params...);
-                    }, _info.resultColumns);
-                }, this->params);
+            // Keyset 分頁，會取代目前的 OrderBy 與 LimitOffset。
+            // 排序鍵會附加在結果欄位之後，因此不能與 DISTINCT 併用
+            template<NotNullColumnConcept... Keys> requires (!IsDistinct)
+            auto Paginate(int pageSize, Keys... keys) const {
+                return Paginate(pageSize, OrderType::ASC, keys...);
             }
 
-            //TODO 支援Size查詢
+            template<NotNullColumnConcept... Keys> requires (!IsDistinct)
+            auto Paginate(int pageSize, OrderType order, Keys... keys) const {
+                static_assert(sizeof...(Keys) > 0, "Paginate requires at least one key column");
+                return Paginator<Info, std::tuple<Keys...> >(_sqlite, _info, std::make_tuple(keys...), pageSize, order);
+            }
+
+            // 只回傳列數，不把資料列搬到 C++。
+            // 結果欄位皆為一般欄位且沒有 DISTINCT/GROUP BY/LIMIT 時直接改寫投影為 COUNT(*)，
+            // 其餘情況包成 SELECT COUNT(*) FROM (...)
+            int64_t Count() const {
+                if constexpr (std::is_null_pointer_v<decltype(_info.groupBy)> &&
+                              IsAllColumns<decltype(_info.resultColumns)>::value) {
+                    if (!_info.isDistinct && !_info.limitOffset.has_value()) {
+                        auto info = MakeSelectStatementInfo(
+                            _info.source,
+                            _info.where,
+                            nullptr,
+                            nullptr,
+                            nullptr,
+                            std::nullopt,
+                            false,
+                            MakeExpr<int64_t>("COUNT(*)")
+                        );
+                        return this->template QueryScalar<int64_t>(GetInfoSql(info) + ";",
+                                                                   GetSelectInfoParams(info));
+                    }
+                }
+                return this->CountSubQuery();
+            }
         };
 
     public:
@@ -263,7 +755,7 @@ namespace TypeSQLite {
                 nullptr,
                 nullptr,
                 nullptr,
-                OrderType::ASC,
+                nullptr,
                 std::nullopt,
                 false,
                 resultCols...
@@ -276,7 +768,7 @@ namespace TypeSQLite {
             auto newSource = JoinSource(this->_source, DataSource<Table2, Expr>{
                                             .type = JoinType::FULL,
                                             .condition = expr
-                                        });
+                                        }, GetSourceWithDefinitions(table2));
             auto newColumns = std::tuple_cat(columns, table2.columns);
             using NewCols = decltype(newColumns);
             using NewSource = decltype(newSource);
@@ -288,7 +780,7 @@ namespace TypeSQLite {
             auto newSource = JoinSource(this->_source, DataSource<Table2, Expr>{
                                             .type = JoinType::INNER,
                                             .condition = expr
-                                        });
+                                        }, GetSourceWithDefinitions(table2));
             auto newColumns = std::tuple_cat(columns, table2.columns);
             using NewCols = decltype(newColumns);
             using NewSource = decltype(newSource);
@@ -300,7 +792,7 @@ namespace TypeSQLite {
             auto newSource = JoinSource(this->_source, DataSource<Table2, Expr>{
                                             .type = JoinType::LEFT,
                                             .condition = expr
-                                        });
+                                        }, GetSourceWithDefinitions(table2));
             auto newColumns = std::tuple_cat(columns, table2.columns);
             using NewCols = decltype(newColumns);
             using NewSource = decltype(newSource);
@@ -312,7 +804,7 @@ namespace TypeSQLite {
             auto newSource = JoinSource(this->_source, DataSource<Table2, Expr>{
                                             .type = JoinType::RIGHT,
                                             .condition = expr
-                                        });
+                                        }, GetSourceWithDefinitions(table2));
             auto newColumns = std::tuple_cat(columns, table2.columns);
             using NewCols = decltype(newColumns);
             using NewSource = decltype(newSource);
@@ -324,7 +816,7 @@ namespace TypeSQLite {
             auto newSource = JoinSource(this->_source, DataSource<Table2, Expr>{
                                             .type = JoinType::CROSS,
                                             .condition = expr
-                                        });
+                                        }, GetSourceWithDefinitions(table2));
             auto newColumns = std::tuple_cat(columns, table2.columns);
             using NewCols = decltype(newColumns);
             using NewSource = decltype(newSource);
@@ -1,5 +1,6 @@
 #pragma once
 #include "TableConstraint.hpp"
+#include "../../ChangeStream.hpp"
 
 namespace TypeSQLite {
     template<ColumnOrTableColumnConcept T, ColumnOrTableColumnConcept... Ts>
@@ -11,6 +12,61 @@ namespace TypeSQLite {
         }
     }
 
+    template<ExprOrColConcept... Exprs>
+    std::string GetReturningSQL(const Exprs &... exprs) {
+        return " RETURNING " + GetExprSqls(exprs...);
+    }
+
+    // UPDATE 的 SET 子句：column = expr
+    template<ColumnOrTableColumnConcept Col, ExprOrColConcept Expr>
+    struct SetClause {
+        Col column;
+        Expr value;
+    };
+
+    template<ColumnOrTableColumnConcept Col, ExprOrColConcept Expr>
+    auto Set(const Col &column, const Expr &value) {
+        return SetClause<Col, Expr>{column, value};
+    }
+
+    template<typename>
+    struct IsSetClause : std::false_type {
+    };
+
+    template<typename Col, typename Expr>
+    struct IsSetClause<SetClause<Col, Expr> > : std::true_type {
+    };
+
+    template<typename T>
+    concept SetClauseConcept = IsSetClause<T>::value;
+
+    template<SetClauseConcept T, SetClauseConcept... Ts>
+    std::string GetSetClausesSQL(const T &set, const Ts &... sets) {
+        // SET 左側不可帶資料表名稱
+        auto sql = std::string(decltype(set.column)::name) + " = " + set.value.sql;
+        if constexpr (sizeof...(Ts) == 0) {
+            return sql;
+        } else {
+            return sql + ", " + GetSetClausesSQL(sets...);
+        }
+    }
+
+    template<typename... Tables>
+    std::string GetFromTablesSQL(std::type_identity<std::tuple<Tables...> >) {
+        std::string sql;
+        ((sql += (sql.empty() ? " FROM " : ", ") + std::string(Tables::name)), ...);
+        return sql;
+    }
+
+    // UPDATE ... FROM 的來源帶有的 CTE 定義
+    template<typename>
+    struct FromTablesWithImpl;
+
+    template<typename... Tables>
+    struct FromTablesWithImpl<std::tuple<Tables...> > {
+        using type = WithDefinitionsTuple<Tables...>;
+    };
+
     template<typename T, typename... Ts>
     std::string GetTableConstraintSQLFromPack(T t, Ts... ts) {
         if constexpr (sizeof...(Ts) == 0) {
@@ -72,7 +128,7 @@ namespace TypeSQLite {
     concept TableDefinitionConcept = IsTableDefinition<T>::value;
 
     template<typename TableDef>
-    class Table final : public SelectAble<decltype(std::declval<TableDef>().columns), SourceInfo<Table<TableDef> > > {
+    class Table : public SelectAble<decltype(std::declval<TableDef>().columns), SourceInfo<Table<TableDef> > > {
     public:
         template<ColumnConcept Col>
         using TableColumn = TableColumn_Base<Table, Col>;
@@ -80,53 +136,165 @@ namespace TypeSQLite {
         TableDef _tableDef;
         const decltype(_tableDef.columns) columns;
 
-    private:
+    protected:
         SQLiteWrapper &_sqlite;
 
-        template<typename _Where, bool AllowEmptyWhere, ColumnOrTableColumnConcept... Ts>
+    private:
+        template<typename... U>
+        static std::string GetInsertSQL() {
+            std::string sql = std::string("INSERT INTO ") + std::string(name) + " (";
+            sql += GetColumnNamesWithOutTableName<U...>();
+            sql += ") VALUES (?";
+            for (auto i = 0; i < sizeof...(U) - 1; ++i) {
+                sql += ",?";
+            }
+            sql += ")";
+            return sql;
+        }
+
+        template<typename... U>
+        static std::string GetUpsertSQL() {
+            return GetInsertSQL<U...>() + " ON CONFLICT DO UPDATE SET " + GetUpdateField<U...>();
+        }
+
+        // Insert/Upsert/InsertMany 的 RETURNING 版本，Cols 為要取回的欄位 tuple
+        template<typename Cols>
+        class [[nodiscard("The RETURNING rows are only available through the returned result.")]]
+                ReturningStatement {
+            Table &_table;
+            Cols _cols;
+
+            template<typename Params>
+            auto Query(const std::string &sql, const Params &params) const {
+                return std::apply([&](auto... cols) {
+                    return std::apply([&](auto &&... allParams) {
+                        return _table._sqlite.template Query<ExprOrColReturnType<decltype(cols)>...>(
+                            sql + GetReturningSQL(cols...) + ";", allParams...);
+                    }, std::tuple_cat(params, GetExprsParamTuple(cols...)));
+                }, _cols);
+            }
+
+        public:
+            explicit ReturningStatement(Table &table, Cols cols) : _table(table), _cols(cols) {
+            }
+
+            template<typename... U>
+            auto Insert(ExprOrColReturnType<U>... values) {
+                if (sizeof...(U) == 0) {
+                    throw std::runtime_error("Insert values cannot be empty");
+                }
+                return Query(GetInsertSQL<U...>(), std::make_tuple(values...));
+            }
+
+            template<typename... U>
+            auto Upsert(ExprOrColReturnType<U>... values) {
+                if (sizeof...(U) == 0) {
+                    throw std::runtime_error("Upsert values cannot be empty");
+                }
+                return Query(GetUpsertSQL<U...>(), std::make_tuple(values..., values...));
+            }
+
+            // 每一列各自執行 INSERT ... RETURNING，結果依插入順序串接
+            template<typename... U>
+            std::vector<RowType<Cols> > InsertMany(const std::vector<std::tuple<ExprOrColReturnType<U>...> > &rows) {
+                if (sizeof...(U) == 0) {
+                    throw std::runtime_error("Insert values cannot be empty");
+                }
+                std::vector<RowType<Cols> > results;
+                if (rows.empty()) {
+                    return results;
+                }
+                results.reserve(rows.size());
+
+                SQLiteWrapper::Transaction transaction(_table._sqlite);
+                auto sql = GetInsertSQL<U...>();
+                for (const auto &row: rows) {
+                    for (auto &&result: Query(sql, row)) {
+                        results.push_back(std::move(result));
+                    }
+                }
+                return results;
+            }
+        };
+
+        template<typename _Where, bool AllowEmptyWhere, typename Sets, typename FromTables = std::tuple<> >
         class [[nodiscard("You must call Execute() for the query to run.")]] UpdateStatement {
+            using With = typename FromTablesWithImpl<FromTables>::type;
+
             const Table &_table;
-            std::tuple<ExprOrColReturnType<Ts>...> datas;
+            Sets _sets;
             _Where _where;
+            With _with;
 
         public:
-            explicit UpdateStatement(_Where where, const Table &table, ExprOrColReturnType<Ts>... ts) : _table(table),
-                datas(ts...),
-                _where(where) {
+            explicit UpdateStatement(_Where where, const Table &table, Sets sets, With with = {}) : _table(table),
+                _sets(sets),
+                _where(where),
+                _with(std::move(with)) {
             }
 
             template<ExprOrColConcept Expr>
             auto Where(const Expr &expr) {
-                return std::apply([&](auto &&... params) {
-                    return UpdateStatement<Expr, AllowEmptyWhere, Ts...>(expr, _table, params...);
-                }, datas);
+                return UpdateStatement<Expr, AllowEmptyWhere, Sets, FromTables>(expr, _table, _sets, _with);
             }
 
             auto WhereAll() {
-                return std::apply([&](auto &&... params) {
-                    return UpdateStatement<_Where, true, Ts...>(_where, _table, params...);
-                }, datas);
+                return UpdateStatement<_Where, true, Sets, FromTables>(_where, _table, _sets, _with);
+            }
+
+            // UPDATE ... FROM：SET 與 WHERE 可以引用其他資料表、CTE 或容器表的欄位，整批轉換在 SQLite 內完成；
+            // CTE 的定義輸出在 UPDATE 之前
+            template<typename... Tables>
+            auto From(const Tables &... tables) {
+                static_assert(sizeof...(Tables) > 0, "From requires at least one table");
+                static_assert((requires { Tables::name; } && ...), "From only accepts tables, CTEs and container tables");
+                return UpdateStatement<_Where, AllowEmptyWhere, Sets, std::tuple<Tables...> >(
+                    _where, _table, _sets, std::tuple_cat(GetSourceWithDefinitions(tables)...));
             }
 
             void Execute() {
                 static_assert(!std::is_same_v<_Where, nullptr_t> || AllowEmptyWhere,
                               "Where clause is required for UpdateStatement.Execute()");
-                auto sql = std::string("UPDATE ") + std::string(name) + " SET " + GetUpdateField<Ts
-                               ...>();
+                auto sql = GetSql() + ";";
+                return std::apply([this, &sql](auto &&... params) {
+                    return _table._sqlite.Execute(sql, params...);
+                }, GetParams());
+            }
+
+            // 以 UPDATE ... RETURNING 在同一個語句內取回更新後的欄位
+            template<ExprOrColConcept... Cols>
+            auto Returning(Cols... cols) {
+                static_assert(!std::is_same_v<_Where, nullptr_t> || AllowEmptyWhere,
+                              "Where clause is required for UpdateStatement.Returning()");
+                auto sql = GetSql() + GetReturningSQL(cols...) + ";";
+                return std::apply([this, &sql](auto &&... params) {
+                    return _table._sqlite.template Query<ExprOrColReturnType<Cols>...>(sql, params...);
+                }, std::tuple_cat(GetParams(), GetExprsParamTuple(cols...)));
+            }
+
+        private:
+            std::string GetSql() const {
+                auto sql = MakeWithSQL(_with) + "UPDATE " + std::string(name) + " SET " +
+                           std::apply([](auto &&... sets) { return GetSetClausesSQL(sets...); }, _sets);
+                sql += GetFromTablesSQL(std::type_identity<FromTables>());
                 if constexpr (!std::is_null_pointer_v<_Where>) {
                     sql += " WHERE " + _where.sql;
                 }
-                sql += ";";
-                auto all_params = [&]() {
-                    if constexpr (std::is_null_pointer_v<_Where>) {
-                        return datas;
-                    } else {
-                        return std::tuple_cat(datas, _where.params);
-                    }
-                }();
-                return std::apply([this, &sql](auto &&... params) {
-                    return _table._sqlite.Execute(sql, params...);
-                }, all_params);
+                return sql;
+            }
+
+            auto GetParams() const {
+                auto withParams = std::apply([](const auto &... definitions) {
+                    return std::tuple_cat(definitions.params...);
+                }, _with);
+                auto setParams = std::tuple_cat(withParams, std::apply([](auto &&... sets) {
+                    return std::tuple_cat(GetParms(sets.value)...);
+                }, _sets));
+                if constexpr (std::is_null_pointer_v<_Where>) {
+                    return setParams;
+                } else {
+                    return std::tuple_cat(setParams, _where.params);
+                }
             }
         };
 
@@ -151,31 +319,52 @@ namespace TypeSQLite {
             void Execute() {
                 static_assert(!std::is_same_v<_Where, nullptr_t> || AllowEmptyWhere,
                               "Where clause is required for DeleteStatement.Execute()");
+                auto sql = GetSql() + ";";
+                return std::apply([this, &sql](auto &&... params) {
+                    return _table._sqlite.Execute(sql, params...);
+                }, GetParams());
+            }
+
+            // 以 DELETE ... RETURNING 在同一個語句內取回被刪除的欄位
+            template<ExprOrColConcept... Cols>
+            auto Returning(Cols... cols) {
+                static_assert(!std::is_same_v<_Where, nullptr_t> || AllowEmptyWhere,
+                              "Where clause is required for DeleteStatement.Returning()");
+                auto sql = GetSql() + GetReturningSQL(cols...) + ";";
+                return std::apply([this, &sql](auto &&... params) {
+                    return _table._sqlite.template Query<ExprOrColReturnType<Cols>...>(sql, params...);
+                }, std::tuple_cat(GetParams(), GetExprsParamTuple(cols...)));
+            }
+
+        private:
+            std::string GetSql() const {
                 auto sql = std::string("DELETE FROM ") + std::string(name);
                 if constexpr (!std::is_null_pointer_v<_Where>) {
                     sql += " WHERE " + _where.sql;
                 }
-                sql += ";";
-                auto all_params = [&]() {
-                    if constexpr (std::is_null_pointer_v<_Where>) {
-                        return std::make_tuple();
-                    } else {
-                        return _where.params;
-                    }
-                }();
-                return std::apply([this, &sql](auto &&... params) {
-                    return _table._sqlite.Execute(sql, params...);
-                }, all_params);
+                return sql;
+            }
+
+            auto GetParams() const {
+                if constexpr (std::is_null_pointer_v<_Where>) {
+                    return std::make_tuple();
+                } else {
+                    return _where.params;
+                }
             }
         };
 
-    public:
-        explicit Table(SQLiteWrapper &sqlite, TableDef table_def) : SelectAble<decltype(table_def.columns), SourceInfo<
-                                                                        Table> >(sqlite, table_def.columns,
-                                                                        SourceInfo<Table>()), _tableDef(table_def),
-                                                                    columns(table_def.columns),
-                                                                    _sqlite(sqlite) {
-            std::string sql = std::string("CREATE TABLE IF NOT EXISTS ") + std::string(name) + " (";
+    protected:
+        // temporary 時建立在 temp schema，供 TempTable 使用；同名的暫存表已存在時會拋出例外
+        Table(SQLiteWrapper &sqlite, TableDef table_def, bool temporary) : SelectAble<decltype(table_def.columns),
+                                                                               SourceInfo<Table> >(
+                                                                               sqlite, table_def.columns,
+                                                                               SourceInfo<Table>()),
+                                                                           _tableDef(table_def),
+                                                                           columns(table_def.columns),
+                                                                           _sqlite(sqlite) {
+            std::string sql = std::string(temporary ? "CREATE TEMP TABLE " : "CREATE TABLE IF NOT EXISTS ") +
+                              std::string(name) + " (";
 
             // 添加列定義
             sql += std::apply([](auto... cols) {
@@ -213,6 +402,10 @@ namespace TypeSQLite {
             sqlite.Execute(sql);
         }
 
+    public:
+        explicit Table(SQLiteWrapper &sqlite, TableDef table_def) : Table(sqlite, table_def, false) {
+        }
+
         template<typename... U>
         void Insert(ExprOrColReturnType<U>... values) {
             //TODO 重啟檢查
@@ -222,15 +415,7 @@ namespace TypeSQLite {
             if (sizeof...(U) == 0) {
                 throw std::runtime_error("Insert values cannot be empty");
             }
-            std::string sql = std::string("INSERT INTO ") + std::string(name) + " (";
-            sql += GetColumnNamesWithOutTableName<U...>();
-            sql += ") VALUES (?";
-            for (auto i = 0; i < sizeof...(U) - 1; ++i) {
-                sql += ",?";
-            }
-            sql += ");";
-
-            _sqlite.Execute(sql, values...);
+            _sqlite.Execute(GetInsertSQL<U...>() + ";", values...);
         }
 
         // 批量插入支援
@@ -251,13 +436,7 @@ namespace TypeSQLite {
             SQLiteWrapper::Transaction transaction(_sqlite);
 
             // 準備 SQL 語句
-            std::string sql = std::string("INSERT INTO ") + std::string(name) + " (";
-            sql += GetColumnNamesWithOutTableName<U...>();
-            sql += ") VALUES (?";
-            for (auto i = 0; i < sizeof...(U) - 1; ++i) {
-                sql += ",?";
-            }
-            sql += ");";
+            std::string sql = GetInsertSQL<U...>() + ";";
 
             // 對每一行執行插入
             for (const auto &row: rows) {
@@ -278,17 +457,7 @@ namespace TypeSQLite {
             if (sizeof...(U) == 0) {
                 throw std::runtime_error("Upsert values cannot be empty");
             }
-            std::string sql = std::string("INSERT INTO ") + std::string(name) + " (";
-            sql += GetColumnNamesWithOutTableName<U...>();
-            sql += ") VALUES (?";
-            for (auto i = 0; i < sizeof...(U) - 1; ++i) {
-                sql += ",?";
-            }
-            sql += ") ON CONFLICT DO UPDATE SET ";
-            sql += GetUpdateField<U...>();
-            sql += ";";
-
-            _sqlite.Execute(sql, values..., values...);
+            _sqlite.Execute(GetUpsertSQL<U...>() + ";", values..., values...);
         }
 
         template<ColumnOrTableColumnConcept... U>
@@ -300,13 +469,61 @@ namespace TypeSQLite {
             if (sizeof...(U) == 0) {
                 throw std::runtime_error("Update values cannot be empty");
             }
-            return UpdateStatement<nullptr_t, false, U...>(nullptr, *this, values...);
+            auto sets = std::make_tuple(Set(U{}, MakeParamExpr(values))...);
+            return UpdateStatement<nullptr_t, false, decltype(sets)>(nullptr, *this, sets);
+        }
+
+        // 以運算式更新欄位，例如 Update(Set(col, col + 1_expr))
+        template<SetClauseConcept... Sets>
+        auto Update(Sets... sets) {
+            static_assert(sizeof...(Sets) > 0, "Update requires at least one Set clause");
+            return UpdateStatement<nullptr_t, false, std::tuple<Sets...> >(nullptr, *this, std::make_tuple(sets...));
         }
 
         auto Delete() {
             return DeleteStatement<nullptr_t, false>(nullptr, *this);
         }
 
+        // INSERT INTO t (cols) SELECT ...：資料不經過 C++ 直接在 SQLite 內複製
+        template<ColumnOrTableColumnConcept... U, typename Select>
+        void InsertFrom(const Select &select) {
+            static_assert(sizeof...(U) > 0, "InsertFrom requires at least one target column");
+            static_assert(std::tuple_size_v<typename Select::Row> == sizeof...(U),
+                          "Select column count must match the target columns");
+            static_assert([]<size_t... I>(std::index_sequence<I...>) {
+                return (std::is_convertible_v<std::tuple_element_t<I, typename Select::Row>, ExprOrColReturnType<U> >
+                        && ...);
+            }(std::index_sequence_for<U...>{}), "Select column types must be convertible to the target columns");
+            auto sql = std::string("INSERT INTO ") + std::string(name) + " (" +
+                       GetColumnNamesWithOutTableName<U...>() + ") " + select.StatementSql() + ";";
+            std::apply([this, &sql](auto &&... params) {
+                _sqlite.Execute(sql, params...);
+            }, select.params);
+        }
+
+        template<ExprOrColConcept... Cols>
+        auto Returning(Cols... cols) {
+            static_assert(sizeof...(Cols) > 0, "Returning requires at least one column");
+            return ReturningStatement<std::tuple<Cols...> >(*this, std::make_tuple(cols...));
+        }
+
+        // 訂閱此資料表的變更，每個提交的交易在消費執行緒上呼叫一次 consumer；
+        // 需要 SQLITE_ENABLE_PREUPDATE_HOOK 才會帶有 oldRow/newRow
+        template<typename Consumer>
+        std::unique_ptr<ChangeStream> Subscribe(Consumer consumer, size_t capacity = 1024) {
+            using Row = RowType<decltype(_tableDef.columns)>;
+            return std::make_unique<ChangeStream>(_sqlite, [consumer = std::move(consumer)](const ChangeBatch &batch) {
+                std::vector<RowChange<Row> > changes;
+                changes.reserve(batch.events.size());
+                for (const auto &event: batch.events) {
+                    changes.push_back(RowChange<Row>{
+                        event.operation, event.rowId, ToRow<Row>(event.oldValues), ToRow<Row>(event.newValues)
+                    });
+                }
+                consumer(changes);
+            }, ChangeStreamOptions{.capacity = capacity, .tables = {std::string(name)}});
+        }
+
         template<typename Column>
         auto operator[](Column column) {
             return TableColumn<Column>();
@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+
+#include "Table.hpp"
+
+namespace TypeSQLite {
+    // PRAGMA temp_store 的值，數值與 PRAGMA 讀回的值相同
+    enum class TempStore {
+        DEFAULT,
+        FILE,
+        MEMORY,
+    };
+
+    inline const char *GetTempStoreString(TempStore store) {
+        switch (store) {
+            case TempStore::FILE:
+                return "FILE";
+            case TempStore::MEMORY:
+                return "MEMORY";
+            default:
+                return "DEFAULT";
+        }
+    }
+
+    // RAII 暫存表：建立在 temp schema，只有目前連線看得到，離開作用域時 DROP。
+    // 用法與 Table 相同（InsertMany、Join、Where、Update(...).From(...)），
+    // 名稱不可與 main schema 的資料表相同，否則未限定的名稱會指向暫存表。
+    // 必須先於 Database 解構。
+    template<TableDefinitionConcept TableDef>
+    class TempTable final : public Table<TableDef> {
+    public:
+        TempTable(SQLiteWrapper &sqlite, TableDef tableDef) : Table<TableDef>(sqlite, tableDef, true) {
+        }
+
+        TempTable(const TempTable &) = delete;
+
+        TempTable &operator=(const TempTable &) = delete;
+
+        ~TempTable() override {
+            try {
+                this->_sqlite.Execute("DROP TABLE IF EXISTS temp." + std::string(TableDef::name) + ";");
+                // DROP 不會觸發 update hook，之後同名的暫存表不能讀到舊的快取結果
+                this->_sqlite.ClearQueryCache();
+            } catch (const std::exception &) {
+                // 仍有未完成的語句時無法 DROP，連線關閉時暫存表會一併消失
+            }
+        }
+    };
+
+    template<TableDefinitionConcept TableDef>
+    struct IsTable<TempTable<TableDef> > : std::true_type {
+    };
+}
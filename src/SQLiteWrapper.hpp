@@ -1,10 +1,20 @@
 #pragma once
+#include <algorithm>
+#include <functional>
+#include <iostream>
 #include <list>
+#include <map>
+#include <optional>
 
 #include "sqlite3.h"
 #include <memory>
+#include <span>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+
+#include "QueryCache.hpp"
+#include "ArrayBinding.hpp"
 
 namespace TypeSQLite {
     template<typename T>
@@ -16,10 +26,17 @@ namespace TypeSQLite {
             } else {
                 sqlite3_bind_text(stmt, index, value, -1, SQLITE_TRANSIENT);
             }
+        } else if constexpr (std::is_integral_v<T> && sizeof(T) > sizeof(int)) {
+            sqlite3_bind_int64(stmt, index, value);
         } else if constexpr (std::is_integral_v<T>) {
             sqlite3_bind_int(stmt, index, value);
         } else if constexpr (std::is_floating_point_v<T>) {
             sqlite3_bind_double(stmt, index, value);
+        } else if constexpr (std::is_same_v<T, std::vector<uint8_t> >) {
+            sqlite3_bind_blob64(stmt, index, value.data(), value.size(), SQLITE_TRANSIENT);
+        } else if constexpr (requires { value.Bind(stmt, index); }) {
+            // ArrayParam 等自行綁定的參數
+            value.Bind(stmt, index);
         } else {
             static_assert([]() { return false; }(), "Unsupported type for bindValue");
         }
@@ -84,6 +101,16 @@ namespace TypeSQLite {
                     t = ValueT{}; // 預設值
                 }
             }
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            if (datatype == SQLITE_INTEGER) {
+                t = sqlite3_column_int64(stmt, colIndex);
+            } else {
+                if constexpr (is_nullable) {
+                    t = nullptr;
+                } else {
+                    t = ValueT{}; // 預設值
+                }
+            }
         } else if constexpr (std::is_same_v<T, std::vector<uint8_t> >) {
             if (datatype == SQLITE_BLOB) {
                 auto pBytes = static_cast<const uint8_t *>(sqlite3_column_blob(stmt, colIndex));
@@ -119,10 +146,6 @@ namespace TypeSQLite {
 
     using AutoStmtPtr = std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>;
 
-    static AutoStmtPtr MakeAutoStmtPtr() {
-        return {nullptr, sqlite3_finalize};
-    }
-
     static AutoStmtPtr MakeAutoStmtPtr(sqlite3_stmt *stmt) {
         return {stmt, sqlite3_finalize};
     }
@@ -160,9 +183,17 @@ namespace TypeSQLite {
             if (!_pStmt) {
                 throw std::runtime_error("RowIterator does not have a valid AutoStmtPtr");
             }
-            if (sqlite3_step(_pStmt->get().get()) != SQLITE_ROW) {
+            auto pStmt = _pStmt->get().get();
+            auto rc = sqlite3_step(pStmt);
+            if (rc != SQLITE_ROW) {
                 _pStmt.reset();
             }
+            if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+                // 例如自訂函式在中途的列回報錯誤，不能被當成結果結束
+                throw std::runtime_error(
+                    "Failed to execute statement: " + std::string(sqlite3_errmsg(sqlite3_db_handle(pStmt))) +
+                    "\nSQL: " + sqlite3_sql(pStmt));
+            }
             return *this;
         }
 
@@ -190,10 +221,34 @@ namespace TypeSQLite {
         AutoStmtPtr _pStmt;
         bool isEmpty = false;
         bool _hasBeenIterated = false;
+        // 語句釋放後呼叫；RETURNING 的寫入在 autocommit 下要到語句結束才提交
+        std::function<void()> _onFinalized;
 
     public:
-        explicit QueryResult(AutoStmtPtr &&pStmt) : _pStmt(std::move(pStmt)) {
-            isEmpty = sqlite3_step(_pStmt.get()) != SQLITE_ROW;
+        explicit QueryResult(AutoStmtPtr &&pStmt, std::function<void()> onFinalized = nullptr)
+            : _pStmt(std::move(pStmt)), _onFinalized(std::move(onFinalized)) {
+            auto rc = sqlite3_step(_pStmt.get());
+            if (rc != SQLITE_ROW && rc != SQLITE_DONE) {
+                // INSERT/UPDATE/DELETE ... RETURNING 的寫入在第一次 step 時完成，錯誤不能被當成空結果
+                throw std::runtime_error(
+                    "Failed to execute statement: " + std::string(sqlite3_errmsg(sqlite3_db_handle(_pStmt.get()))) +
+                    "\nSQL: " + sqlite3_sql(_pStmt.get()));
+            }
+            isEmpty = rc != SQLITE_ROW;
+        }
+
+        QueryResult(QueryResult &&other) noexcept
+            : _pStmt(std::move(other._pStmt)), isEmpty(other.isEmpty), _hasBeenIterated(other._hasBeenIterated),
+              _onFinalized(std::exchange(other._onFinalized, nullptr)) {
+        }
+
+        QueryResult &operator=(QueryResult &&) = delete;
+
+        ~QueryResult() {
+            _pStmt.reset();
+            if (_onFinalized) {
+                _onFinalized();
+            }
         }
 
         RowIterator<Ts...> begin() {
@@ -218,6 +273,21 @@ namespace TypeSQLite {
         }
     };
 
+    // lookaside 是每個連線預先配置的小區塊記憶體池，slotSize 為每格位元組數
+    struct LookasideConfig {
+        int slotSize = 1200;
+        int slots = 100;
+    };
+
+    // 開啟連線時套用的設定
+    struct OpenOptions {
+        int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+        // PRAGMA mmap_size，讀取時直接對應檔案而不必從 page cache 複製；會被 SQLITE_MAX_MMAP_SIZE 限制
+        std::optional<int64_t> mmapSize;
+        // SQLITE_DBCONFIG_LOOKASIDE，未指定時使用 Configure 設定的全域預設值；slots 為 0 代表停用
+        std::optional<LookasideConfig> lookaside;
+    };
+
     class SQLiteWrapper final {
     public:
         // Transaction 類別，使用 RAII 模式管理交易
@@ -270,53 +340,354 @@ namespace TypeSQLite {
             }
         };
 
+    public:
+        using UpdateHook = std::function<void(int operation, const char *database, const char *table,
+                                              sqlite3_int64 rowId)>;
+        using TransactionHook = std::function<void()>;
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+        using PreUpdateHook = std::function<void(sqlite3 *db, int operation, const char *database, const char *table,
+                                                 sqlite3_int64 oldRowId, sqlite3_int64 newRowId)>;
+#endif
+
+    private:
+        // 每個連線只能設定一個 update/commit/rollback/preupdate hook，這裡分派給多個監聽者
+        struct HookListeners {
+            int nextId = 0;
+            std::map<int, UpdateHook> update;
+            std::map<int, TransactionHook> commit;
+            std::map<int, TransactionHook> rollback;
+            std::map<int, TransactionHook> committed;
+            // commit hook 已觸發但 COMMIT 尚未完成
+            bool commitPending = false;
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            std::map<int, PreUpdateHook> preUpdate;
+#endif
+        };
+
+        // 宣告在 _dbPtr 之前，確保關閉連線時 hook 的 user data 仍然有效
+        std::unique_ptr<HookListeners> _hooks = std::make_unique<HookListeners>();
+
+        template<typename Hook>
+        static void InvokeHooks(const std::map<int, Hook> &hooks, const auto &... args) noexcept {
+            for (const auto &[id, hook]: hooks) {
+                try {
+                    hook(args...);
+                } catch (const std::exception &exception) {
+                    // 例外不能穿過 SQLite 的 C 堆疊
+                    std::cerr << exception.what() << std::endl;
+                }
+            }
+        }
+
+        static void UpdateHookCallback(void *pListeners, int operation, const char *database, const char *table,
+                                       sqlite3_int64 rowId) {
+            InvokeHooks(static_cast<HookListeners *>(pListeners)->update, operation, database, table, rowId);
+        }
+
+        static int CommitHookCallback(void *pListeners) {
+            auto *listeners = static_cast<HookListeners *>(pListeners);
+            listeners->commitPending = !listeners->committed.empty();
+            InvokeHooks(listeners->commit);
+            return 0;
+        }
+
+        static void RollbackHookCallback(void *pListeners) {
+            auto *listeners = static_cast<HookListeners *>(pListeners);
+            listeners->commitPending = false;
+            InvokeHooks(listeners->rollback);
+        }
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+        static void PreUpdateHookCallback(void *pListeners, sqlite3 *db, int operation, const char *database,
+                                          const char *table, sqlite3_int64 oldRowId, sqlite3_int64 newRowId) {
+            InvokeHooks(static_cast<HookListeners *>(pListeners)->preUpdate, db, operation, database, table, oldRowId,
+                        newRowId);
+        }
+#endif
+
+        void InstallHooks() {
+            auto *pListeners = _hooks.get();
+            sqlite3_update_hook(_dbPtr.get(), _hooks->update.empty() ? nullptr : UpdateHookCallback,
+                                _hooks->update.empty() ? nullptr : pListeners);
+            auto hasCommit = !_hooks->commit.empty() || !_hooks->committed.empty();
+            auto hasRollback = !_hooks->rollback.empty() || !_hooks->committed.empty();
+            sqlite3_commit_hook(_dbPtr.get(), hasCommit ? CommitHookCallback : nullptr,
+                                hasCommit ? pListeners : nullptr);
+            sqlite3_rollback_hook(_dbPtr.get(), hasRollback ? RollbackHookCallback : nullptr,
+                                  hasRollback ? pListeners : nullptr);
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            sqlite3_preupdate_hook(_dbPtr.get(), _hooks->preUpdate.empty() ? nullptr : PreUpdateHookCallback,
+                                   _hooks->preUpdate.empty() ? nullptr : pListeners);
+#endif
+        }
+
+        AutoStmtPtr Prepare(const std::string &sql, std::vector<std::string> *pTablesRead = nullptr) const {
+            if (pTablesRead) {
+                // 利用 authorizer 在編譯時取得語句實際讀取的資料表（包含子查詢與 view 展開後的資料表）
+                sqlite3_set_authorizer(_dbPtr.get(), [](void *pTables, int action, const char *table, const char *,
+                                                        const char *, const char *) {
+                    if (action == SQLITE_READ && table) {
+                        auto &tables = *static_cast<std::vector<std::string> *>(pTables);
+                        if (std::find(tables.begin(), tables.end(), table) == tables.end()) {
+                            tables.emplace_back(table);
+                        }
+                    }
+                    return SQLITE_OK;
+                }, pTablesRead);
+            }
+            sqlite3_stmt *pStmt = nullptr;
+            auto rc = sqlite3_prepare_v2(_dbPtr.get(), sql.c_str(), -1, &pStmt, nullptr);
+            if (pTablesRead) {
+                sqlite3_set_authorizer(_dbPtr.get(), nullptr, nullptr);
+            }
+            if (rc != SQLITE_OK) {
+                throw std::runtime_error(
+                    "Failed to prepare statement: " + std::string(sqlite3_errmsg(_dbPtr.get())) +
+                    "\nSQL: " + sql);
+            }
+            return MakeAutoStmtPtr(pStmt);
+        }
+
     public:
         std::string _db_path;
         std::unique_ptr<sqlite3, decltype(&sqlite3_close)> _dbPtr = {nullptr, sqlite3_close};
 
-        explicit SQLiteWrapper(const std::string &dbPath,
-                               const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE
-        ) : _db_path(std::move(dbPath)) {
+    private:
+        // 宣告在 _dbPtr 之後，先於連線釋放
+        std::unique_ptr<QueryCache> _queryCache;
+        std::vector<int> _queryCacheHooks;
+
+        void SyncQueryCache() const {
+            auto dataVersion = std::get<0>(*Query<int64_t>("PRAGMA data_version;").begin());
+            _queryCache->Sync(dataVersion, sqlite3_total_changes64(_dbPtr.get()));
+        }
+
+        void Open(int flags) {
             sqlite3 *pDb = nullptr;
             if (sqlite3_open_v2(_db_path.c_str(), &pDb, flags, nullptr) != SQLITE_OK) {
                 std::string errMsg = pDb ? sqlite3_errmsg(pDb) : "Unknown error";
+                sqlite3_close(pDb);
                 throw std::runtime_error("Can't open database: " + errMsg + "\nPath: " + _db_path);
             }
             _dbPtr = {pDb, sqlite3_close};
         }
 
+    public:
+        explicit SQLiteWrapper(const std::string &dbPath,
+                               const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE
+        ) : _db_path(std::move(dbPath)) {
+            Open(flags);
+        }
+
+        SQLiteWrapper(const std::string &dbPath, const OpenOptions &options) : _db_path(dbPath) {
+            Open(options.flags);
+            if (options.lookaside) {
+                // 必須在連線配置任何 lookaside 記憶體之前設定，由 SQLite 一次配置整塊緩衝區
+                auto rc = sqlite3_db_config(_dbPtr.get(), SQLITE_DBCONFIG_LOOKASIDE, nullptr,
+                                            options.lookaside->slotSize, options.lookaside->slots);
+                if (rc != SQLITE_OK) {
+                    throw std::runtime_error("Failed to configure lookaside: " + std::string(sqlite3_errstr(rc)));
+                }
+            }
+            if (options.mmapSize) {
+                SetMmapSize(*options.mmapSize);
+            }
+        }
+
+        ~SQLiteWrapper() {
+            DisableQueryCache();
+        }
+
+        // 回傳實際生效的大小，可能因編譯上限而小於要求的值，不支援 mmap 時為 0
+        int64_t SetMmapSize(int64_t bytes) {
+            Query<int64_t>("PRAGMA mmap_size = " + std::to_string(bytes) + ";");
+            return GetMmapSize();
+        }
+
+        int64_t GetMmapSize() const {
+            // VFS 不回報 mmap 大小時（例如 memdb）PRAGMA 不會回傳任何列
+            auto rows = Query<int64_t>("PRAGMA mmap_size;").ToVector();
+            return rows.empty() ? 0 : std::get<0>(rows.front());
+        }
+
+        // 以 sqlite3_serialize 取得資料庫映像，格式與資料庫檔案相同
+        std::vector<uint8_t> Serialize() const {
+            sqlite3_int64 size = 0;
+            std::unique_ptr<unsigned char, decltype(&sqlite3_free)> pImage(
+                sqlite3_serialize(_dbPtr.get(), "main", &size, 0), sqlite3_free);
+            if (!pImage) {
+                if (size == 0) {
+                    return {};
+                }
+                throw std::runtime_error("Failed to serialize database: " + std::string(sqlite3_errmsg(_dbPtr.get())));
+            }
+            return {pImage.get(), pImage.get() + size};
+        }
+
+        // 以映像的副本取代目前的資料庫內容，副本由 SQLite 管理
+        void Deserialize(std::span<const uint8_t> image, bool readonly) {
+            auto pImage = static_cast<unsigned char *>(sqlite3_malloc64(image.size()));
+            if (!pImage && !image.empty()) {
+                throw std::bad_alloc();
+            }
+            std::copy(image.begin(), image.end(), pImage);
+            unsigned flags = SQLITE_DESERIALIZE_FREEONCLOSE;
+            flags |= readonly ? SQLITE_DESERIALIZE_READONLY : SQLITE_DESERIALIZE_RESIZEABLE;
+            // 失敗時 SQLite 也會釋放 FREEONCLOSE 的緩衝區
+            auto rc = sqlite3_deserialize(_dbPtr.get(), "main", pImage, image.size(), image.size(), flags);
+            if (rc != SQLITE_OK) {
+                throw std::runtime_error("Failed to deserialize database: " + std::string(sqlite3_errstr(rc)));
+            }
+        }
+
+        // 直接使用呼叫端的記憶體（例如 mmap 的檔案）不複製，只能唯讀，且記憶體必須存活到連線關閉
+        void DeserializeNoCopy(std::span<const uint8_t> image) {
+            auto rc = sqlite3_deserialize(_dbPtr.get(), "main", const_cast<uint8_t *>(image.data()), image.size(),
+                                          image.size(), SQLITE_DESERIALIZE_READONLY);
+            if (rc != SQLITE_OK) {
+                throw std::runtime_error("Failed to deserialize database: " + std::string(sqlite3_errstr(rc)));
+            }
+            // 開啟 mmap 讀取後，分頁直接指向映像而不會再複製到 page cache
+            SetMmapSize(static_cast<int64_t>(image.size()));
+        }
+
+        int AddUpdateHook(UpdateHook hook) {
+            auto id = _hooks->nextId++;
+            _hooks->update.emplace(id, std::move(hook));
+            InstallHooks();
+            return id;
+        }
+
+        int AddCommitHook(TransactionHook hook) {
+            auto id = _hooks->nextId++;
+            _hooks->commit.emplace(id, std::move(hook));
+            InstallHooks();
+            return id;
+        }
+
+        int AddRollbackHook(TransactionHook hook) {
+            auto id = _hooks->nextId++;
+            _hooks->rollback.emplace(id, std::move(hook));
+            InstallHooks();
+            return id;
+        }
+
+        // 交易確實寫入後才呼叫；COMMIT 失敗時不會呼叫
+        int AddCommittedHook(TransactionHook hook) {
+            auto id = _hooks->nextId++;
+            _hooks->committed.emplace(id, std::move(hook));
+            InstallHooks();
+            return id;
+        }
+
+        // commit hook 在寫入前觸發，COMMIT 仍可能因 SQLITE_BUSY 等失敗而留在交易中；
+        // 語句結束後連線回到 autocommit 才代表交易已寫入。
+        // 由執行語句的地方在 step 之後呼叫，不經過 SQLite 的 C 堆疊
+        void NotifyCommitted() const {
+            if (_hooks->commitPending && sqlite3_get_autocommit(_dbPtr.get())) {
+                _hooks->commitPending = false;
+                InvokeHooks(_hooks->committed);
+            }
+        }
+
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+        // 可在回呼中透過 sqlite3_preupdate_old/new 取得變更前後的欄位值
+        int AddPreUpdateHook(PreUpdateHook hook) {
+            auto id = _hooks->nextId++;
+            _hooks->preUpdate.emplace(id, std::move(hook));
+            InstallHooks();
+            return id;
+        }
+#endif
+
+        void RemoveHook(int id) {
+            _hooks->update.erase(id);
+            _hooks->commit.erase(id);
+            _hooks->rollback.erase(id);
+            _hooks->committed.erase(id);
+            if (_hooks->committed.empty()) {
+                _hooks->commitPending = false;
+            }
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+            _hooks->preUpdate.erase(id);
+#endif
+            InstallHooks();
+        }
+
+        // 啟用查詢結果快取；maxBytes 為實體化結果的記憶體上限，超過時以 LRU 淘汰
+        void EnableQueryCache(size_t maxBytes) {
+            DisableQueryCache();
+            _queryCache = std::make_unique<QueryCache>(maxBytes);
+            auto *pCache = _queryCache.get();
+            _queryCacheHooks = {
+                AddUpdateHook([pCache](int, const char *, const char *table, sqlite3_int64) {
+                    pCache->OnRowChanged(table);
+                }),
+                // ROLLBACK 不會觸發 update hook，交易內快取的結果可能已失效
+                AddRollbackHook([pCache] { pCache->Clear(); })
+            };
+        }
+
+        void DisableQueryCache() {
+            for (auto id: _queryCacheHooks) {
+                RemoveHook(id);
+            }
+            _queryCacheHooks.clear();
+            _queryCache.reset();
+        }
+
+        // 結構變更（DROP/ALTER）不會經過 hook，需要手動清除
+        void ClearQueryCache() {
+            if (_queryCache) {
+                _queryCache->Clear();
+            }
+        }
+
+        QueryCacheStats GetQueryCacheStats() const {
+            return _queryCache ? _queryCache->Stats() : QueryCacheStats{};
+        }
+
         template<typename... ResultColumns, typename... Parameters>
         QueryResult<ResultColumns...> Query(const std::string &sql, Parameters... parameters) const {
-            auto pAutoStmt = MakeAutoStmtPtr();
-            {
-                sqlite3_stmt *pStmt = nullptr;
-                if (sqlite3_prepare_v2(_dbPtr.get(), sql.c_str(), -1, &pStmt, nullptr) != SQLITE_OK) {
-                    throw std::runtime_error(
-                        "Failed to prepare statement: " + std::string(sqlite3_errmsg(_dbPtr.get())) +
-                        "\nSQL: " + sql);
-                }
-                pAutoStmt = MakeAutoStmtPtr(pStmt);
+            auto pAutoStmt = Prepare(sql);
+            int index = 1;
+            (BindValue(pAutoStmt.get(), index++, parameters), ...);
+            if (_hooks->committed.empty()) {
+                return QueryResult<ResultColumns...>(std::move(pAutoStmt));
             }
+            return QueryResult<ResultColumns...>(std::move(pAutoStmt), [this] { NotifyCommitted(); });
+        }
+
+        // 與 Query 相同，但結果會實體化並在快取啟用時以 (SQL, 參數) 為 key 共用
+        template<typename... ResultColumns, typename... Parameters>
+        std::shared_ptr<const std::vector<std::tuple<ResultColumns...> > > CachedQuery(
+            const std::string &sql, Parameters... parameters) const {
+            using Rows = std::vector<std::tuple<ResultColumns...> >;
+            if (!_queryCache) {
+                return std::make_shared<const Rows>(Query<ResultColumns...>(sql, parameters...).ToVector());
+            }
+            SyncQueryCache();
+            auto key = QueryCache::MakeKey<std::tuple<ResultColumns...> >(sql, parameters...);
+            if (auto rows = _queryCache->Find<Rows>(key)) {
+                return rows;
+            }
+            std::vector<std::string> tables;
+            auto pAutoStmt = Prepare(sql, &tables);
             int index = 1;
             (BindValue(pAutoStmt.get(), index++, parameters), ...);
-            return QueryResult<ResultColumns...>(std::move(pAutoStmt));
+            auto rows = std::make_shared<const Rows>(QueryResult<ResultColumns...>(std::move(pAutoStmt)).ToVector());
+            _queryCache->Store(key, rows, EstimateRowsSize(*rows), tables);
+            return rows;
         }
 
         template<typename... Parameter>
         void Execute(const std::string &sql, const Parameter &... values) const {
-            auto pAutoStmt = MakeAutoStmtPtr();
-            {
-                sqlite3_stmt *pStmt = nullptr;
-                if (sqlite3_prepare_v2(_dbPtr.get(), sql.c_str(), -1, &pStmt, nullptr) != SQLITE_OK) {
-                    throw std::runtime_error(
-                        "Failed to prepare statement: " + std::string(sqlite3_errmsg(_dbPtr.get())) +
-                        "\nSQL: " + sql);
-                }
-                pAutoStmt = MakeAutoStmtPtr(pStmt);
-            }
+            auto pAutoStmt = Prepare(sql);
             int index = 1;
             (BindValue(pAutoStmt.get(), index++, values), ...);
-            if (sqlite3_step(pAutoStmt.get()) != SQLITE_DONE) {
+            auto rc = sqlite3_step(pAutoStmt.get());
+            NotifyCommitted();
+            if (rc != SQLITE_DONE) {
                 throw std::runtime_error(
                     "Failed to execute statement: " + std::string(sqlite3_errmsg(_dbPtr.get())) +
                     "\nSQL: " + sql);
@@ -7,12 +7,18 @@
 #include "SQLiteStruct/Query/Table.hpp"
 #include "SQLiteStruct/Query/TableConstraint.hpp"
 #include "SQLiteStruct/Query/Index.hpp"
+#include "SQLiteStruct/Query/ContainerTable.hpp"
+#include "SQLiteStruct/Query/TempTable.hpp"
+#include "SQLiteStruct/Query/CommonTableExpression.hpp"
 #include "SQLiteStruct/Expressions/Expressions.hpp"
+#include "SQLiteStruct/Expressions/OrderingTerm.hpp"
 #include "SQLiteStruct/Expressions/AggregateFunctions.hpp"
 #include "SQLiteStruct/Expressions/WindowFunctions.hpp"
 #include "SQLiteStruct/Expressions/MathFunctions.hpp"
 #include "SQLiteStruct/Expressions/ScalarFunctions.hpp"
 #include "SQLiteStruct/Expressions/DateTimeFunctions.hpp"
+#include "SQLiteStruct/Expressions/UserFunctions.hpp"
 #include "SQliteStruct/Database.hpp"
 #include "SQLiteStruct/Order.hpp"
 #include "SQLiteWrapper.hpp"
+#include "Configure.hpp"
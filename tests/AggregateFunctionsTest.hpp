@@ -463,3 +463,107 @@ TEST_F(AggregateFunctionTest, AllAggregateFunctionsWithGroupBy) {
     }
 }
 
+
+// 測試聚合函式作為視窗函式：累計總和與移動平均
+TEST_F(AggregateFunctionTest, AggregateAsWindowFunction) {
+    auto results = userTable.Select(
+        userTable[NameColumn],
+        Sum(userTable[ScoreColumn]).OrderBy(userTable[ScoreColumn], OrderType::ASC)
+        .Rows(UnboundedPreceding(), CurrentRow()),
+        Avg(userTable[ScoreColumn]).OrderBy(userTable[ScoreColumn], OrderType::ASC)
+        .Rows(Preceding(1), Following(1)),
+        Count(userTable[NameColumn]).Over()
+    ).OrderBy(userTable[ScoreColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 4);
+    // 分數排序：Charlie 78.5, Alice 85.5, David 88.0, Bob 92.0
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 78.5);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 78.5 + 85.5);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[3]), 78.5 + 85.5 + 88.0 + 92.0);
+    EXPECT_DOUBLE_EQ(std::get<2>(results[0]), (78.5 + 85.5) / 2);
+    EXPECT_DOUBLE_EQ(std::get<2>(results[1]), (78.5 + 85.5 + 88.0) / 3);
+    for (const auto &row: results) {
+        EXPECT_DOUBLE_EQ(std::get<3>(row), 4);
+    }
+}
+
+// 測試聚合函式的 PARTITION BY 與具名視窗
+TEST_F(AggregateFunctionTest, AggregatePartitionAndNamedWindow) {
+    auto byAge = Window<"by_age">().PartitionedBy(userTable[AgeColumn]);
+    auto results = userTable.Select(
+        userTable[NameColumn],
+        Max(userTable[ScoreColumn]).PartitionedBy(userTable[AgeColumn]),
+        Count(userTable[NameColumn]).Over(byAge)
+    ).Window(byAge).OrderBy(userTable[NameColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 4);
+    // Alice 與 Charlie 同為 25 歲
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 85.5);
+    EXPECT_DOUBLE_EQ(std::get<2>(results[0]), 2);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 92.0);
+    EXPECT_DOUBLE_EQ(std::get<2>(results[1]), 1);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[2]), 85.5);
+}
+
+// 測試 FILTER 子句：單次查詢計算多個條件統計
+TEST_F(AggregateFunctionTest, AggregateFilter) {
+    auto results = userTable.Select(
+        Count(userTable[NameColumn]).Filter(userTable[AgeColumn] == 25_expr),
+        Count(userTable[NameColumn]).Filter(userTable[ScoreColumn] > 86.0_expr),
+        Avg(userTable[ScoreColumn]).Filter(userTable[AgeColumn] >= 30_expr),
+        Total(userTable[ScoreColumn]).Filter(userTable[NameColumn] == "Nobody"_expr)
+    ).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[0]), 2);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 2);
+    EXPECT_DOUBLE_EQ(std::get<2>(results[0]), (92.0 + 88.0) / 2);
+    EXPECT_DOUBLE_EQ(std::get<3>(results[0]), 0);
+}
+
+// 測試 FILTER 與 GROUP BY、視窗函式組合
+TEST_F(AggregateFunctionTest, AggregateFilterWithGroupByAndWindow) {
+    auto grouped = userTable.Select(
+        userTable[AgeColumn],
+        Count(userTable[NameColumn]).Filter(userTable[ScoreColumn] > 80.0_expr)
+    ).GroupBy(userTable[AgeColumn]).Results().ToVector();
+
+    ASSERT_EQ(grouped.size(), 3);
+    EXPECT_EQ(std::get<0>(grouped[0]), 25);
+    EXPECT_DOUBLE_EQ(std::get<1>(grouped[0]), 1);
+
+    auto windowed = userTable.Select(
+        userTable[NameColumn],
+        Total(userTable[ScoreColumn]).Filter(userTable[AgeColumn] > 25_expr)
+        .OrderBy(userTable[ScoreColumn], OrderType::ASC)
+        .Rows(UnboundedPreceding(), CurrentRow())
+    ).OrderBy(userTable[ScoreColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(windowed.size(), 4);
+    // 分數排序：Charlie 78.5, Alice 85.5 皆為 25 歲，不計入
+    EXPECT_DOUBLE_EQ(std::get<1>(windowed[1]), 0);
+    EXPECT_DOUBLE_EQ(std::get<1>(windowed[2]), 88.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(windowed[3]), 88.0 + 92.0);
+}
+
+// 測試 GROUP_CONCAT 與 FILTER、視窗函式組合
+TEST_F(AggregateFunctionTest, GroupConcatFunction) {
+    auto results = userTable.Select(
+        GroupConcat(userTable[NameColumn], "|"_expr).Filter(userTable[AgeColumn] > 25_expr)
+    ).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 1);
+    auto names = std::get<0>(results[0]);
+    EXPECT_EQ(names.size(), std::string("Bob|David").size());
+    EXPECT_NE(names.find("Bob"), std::string::npos);
+    EXPECT_NE(names.find("David"), std::string::npos);
+
+    auto windowed = userTable.Select(
+        userTable[NameColumn],
+        GroupConcat(userTable[NameColumn], ","_expr).OrderBy(userTable[ScoreColumn], OrderType::ASC)
+    ).OrderBy(userTable[ScoreColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(windowed.size(), 4);
+    EXPECT_EQ(std::get<1>(windowed[0]), "Charlie");
+    EXPECT_EQ(std::get<1>(windowed[3]), "Charlie,Alice,David,Bob");
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <span>
+#include <string_view>
+#include "Common.hpp"
+
+#ifdef SQLITE_ENABLE_CARRAY
+// ============ 陣列 IN 參數測試 ============
+
+class ArrayInTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("David", 40, 88.0);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試整數陣列
+TEST_F(ArrayInTest, IntegerArray) {
+    std::vector<int64_t> ages = {30, 40, 99};
+    auto results = userTable.Select(userTable[NameColumn])
+            .Where(In(userTable[AgeColumn], ages))
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "David");
+}
+
+// 測試字串陣列（std::string 與 std::string_view）
+TEST_F(ArrayInTest, StringArray) {
+    std::vector<std::string> names = {"Alice", "Charlie"};
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Where(In(userTable[NameColumn], names)).Count(), 2);
+
+    std::vector<std::string_view> views = {"Bob"};
+    auto results = userTable.Select(userTable[AgeColumn])
+            .Where(In(userTable[NameColumn], std::span<const std::string_view>(views)))
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<0>(results[0]), 30);
+}
+
+// 測試空陣列不符合任何列
+TEST_F(ArrayInTest, EmptyArray) {
+    std::vector<int64_t> ages;
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Where(In(userTable[AgeColumn], ages)).Count(), 0);
+}
+
+// 測試 SQL 文字與陣列長度無關
+TEST_F(ArrayInTest, SqlIndependentOfLength) {
+    std::vector<int64_t> small = {25};
+    std::vector<int64_t> large(10000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<int64_t>(i);
+    }
+    auto smallQuery = userTable.Select(userTable[NameColumn]).Where(In(userTable[AgeColumn], small));
+    auto largeQuery = userTable.Select(userTable[NameColumn]).Where(In(userTable[AgeColumn], large));
+
+    EXPECT_EQ(smallQuery.StatementSql(), largeQuery.StatementSql());
+    EXPECT_EQ(smallQuery.Count(), 1);
+    EXPECT_EQ(largeQuery.Count(), 4);
+}
+
+// 測試查詢快取以陣列內容區分結果
+TEST_F(ArrayInTest, QueryCacheKeyIncludesValues) {
+    db.EnableQueryCache(1 << 20);
+    std::vector<int64_t> first = {25};
+    std::vector<int64_t> second = {30, 35};
+
+    auto firstRows = userTable.Select(userTable[NameColumn]).Where(In(userTable[AgeColumn], first)).CachedResults();
+    auto secondRows = userTable.Select(userTable[NameColumn]).Where(In(userTable[AgeColumn], second)).CachedResults();
+
+    EXPECT_EQ(firstRows->size(), 1);
+    EXPECT_EQ(secondRows->size(), 2);
+    EXPECT_EQ(db.GetQueryCacheStats().hits, 0);
+}
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ 線上備份測試 ============
+
+class BackupTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        // 產生足夠多的頁面，讓備份需要多個步驟
+        db.CreateTransaction([this] {
+            for (int i = 0; i < 500; ++i) {
+                userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>(
+                    std::string(200, 'a' + i % 26), i, i * 0.5);
+            }
+        });
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+        std::remove("test_backup.db");
+    }
+};
+
+// 測試分段備份到檔案並回報進度
+TEST_F(BackupTest, BackupToPath) {
+    int steps = 0;
+    int lastRemaining = -1;
+    bool completed = db.BackupTo("test_backup.db", BackupOptions{
+                                     .pagesPerStep = 5,
+                                     .onProgress = [&](const BackupProgress &progress) {
+                                         ++steps;
+                                         lastRemaining = progress.remaining;
+                                         return true;
+                                     }
+                                 });
+    EXPECT_TRUE(completed);
+    EXPECT_GT(steps, 2);
+    EXPECT_EQ(lastRemaining, 0);
+
+    Database backup{"test_backup.db", UserTableDefinition};
+    auto &backupTable = backup.GetTable<decltype(UserTableDefinition)>();
+    EXPECT_EQ(backupTable.Select(backupTable[NameColumn]).Count(), 500);
+}
+
+// 測試備份到另一個 Database 物件
+TEST_F(BackupTest, BackupToDatabase) {
+    Database backup{"test_backup.db", UserTableDefinition};
+    auto &backupTable = backup.GetTable<decltype(UserTableDefinition)>();
+    EXPECT_TRUE(db.BackupTo(backup));
+    EXPECT_EQ(backupTable.Select(backupTable[NameColumn]).Where(backupTable[AgeColumn] >= 250_expr).Count(), 250);
+}
+
+// 測試進度回呼回傳 false 時取消備份
+TEST_F(BackupTest, CancelBackup) {
+    int steps = 0;
+    bool completed = db.BackupTo("test_backup.db", BackupOptions{
+                                     .pagesPerStep = 1,
+                                     .onProgress = [&](const BackupProgress &) {
+                                         return ++steps < 3;
+                                     }
+                                 });
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(steps, 3);
+}
+
+// 測試 VACUUM INTO 產生可用的副本
+TEST_F(BackupTest, VacuumInto) {
+    userTable.Delete().Where(userTable[AgeColumn] >= 100_expr).Execute();
+    db.VacuumInto("test_backup.db");
+    EXPECT_THROW(db.VacuumInto("test_backup.db"), std::runtime_error);
+
+    Database backup{"test_backup.db", UserTableDefinition};
+    auto &backupTable = backup.GetTable<decltype(UserTableDefinition)>();
+    EXPECT_EQ(backupTable.Select(backupTable[NameColumn]).Count(), 100);
+}
+
+// 測試來源被其他連線鎖住時，即使 sleepBetweenSteps 為 0 也會等待後重試
+TEST_F(BackupTest, BusySourceWaits) {
+    sqlite3 *pLocker = nullptr;
+    ASSERT_EQ(sqlite3_open("test_database.db", &pLocker), SQLITE_OK);
+    ASSERT_EQ(sqlite3_exec(pLocker, "BEGIN EXCLUSIVE;", nullptr, nullptr, nullptr), SQLITE_OK);
+
+    int busySteps = 0;
+    auto start = std::chrono::steady_clock::now();
+    bool completed = db.BackupTo("test_backup.db", BackupOptions{
+                                     .pagesPerStep = -1,
+                                     .onProgress = [&](const BackupProgress &) {
+                                         if (pLocker && ++busySteps == 3) {
+                                             sqlite3_exec(pLocker, "COMMIT;", nullptr, nullptr, nullptr);
+                                             sqlite3_close(pLocker);
+                                             pLocker = nullptr;
+                                         }
+                                         return true;
+                                     }
+                                 });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(busySteps, 3);
+    EXPECT_GE(elapsed, 3 * BackupBusyDelay);
+}
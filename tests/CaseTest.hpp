@@ -0,0 +1,72 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ CASE 運算式測試 ============
+
+class CaseTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("David", 40, 88.0);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試搜尋式 CASE 分組
+TEST_F(CaseTest, SearchedCase) {
+    auto bucket = Case()
+            .When(userTable[AgeColumn] < 30_expr, "young"_expr)
+            .When(userTable[AgeColumn] < 40_expr, "middle"_expr)
+            .Else("senior"_expr);
+    static_assert(std::is_same_v<decltype(bucket)::returnType, std::string>);
+
+    auto results = userTable.Select(userTable[NameColumn], bucket).Results().ToVector();
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(std::get<1>(results[0]), "young");
+    EXPECT_EQ(std::get<1>(results[1]), "middle");
+    EXPECT_EQ(std::get<1>(results[2]), "middle");
+    EXPECT_EQ(std::get<1>(results[3]), "senior");
+}
+
+// 測試簡單 CASE 與分支型別的共同型別
+TEST_F(CaseTest, SimpleCase) {
+    auto bonus = Case(userTable[NameColumn])
+            .When("Alice"_expr, userTable[AgeColumn])
+            .When("Bob"_expr, 1.5_expr)
+            .Else(userTable[ScoreColumn]);
+    static_assert(std::is_same_v<decltype(bonus)::returnType, double>);
+
+    auto results = userTable.Select(bonus).Results().ToVector();
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[0]), 25);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[1]), 1.5);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[2]), 78.5);
+}
+
+// 測試條件聚合：單次掃描計算多個條件計數
+TEST_F(CaseTest, ConditionalAggregation) {
+    auto results = userTable.Select(
+        Sum(Case().When(userTable[ScoreColumn] > 85.0_expr, 1.0_expr).Else(0.0_expr)),
+        Sum(Case().When(userTable[AgeColumn] >= 35_expr, userTable[ScoreColumn]).End())
+    ).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[0]), 3);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 78.5 + 88.0);
+}
+
+// 測試沒有 ELSE 時不符合的列為 NULL
+TEST_F(CaseTest, EndWithoutElse) {
+    auto label = Case().When(userTable[NameColumn] == "Bob"_expr, "bob"_expr).End();
+    auto results = userTable.Select(Count(label)).Results().ToVector();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[0]), 1);
+}
@@ -0,0 +1,218 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include "Common.hpp"
+
+// ============ 變更資料擷取 (CDC) 測試 ============
+
+// 在消費執行緒收集結果，測試執行緒等待
+template<typename T>
+class ChangeCollector {
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<T> _items;
+
+public:
+    void Add(const T &item) {
+        {
+            std::lock_guard lock(_mutex);
+            _items.push_back(item);
+        }
+        _cv.notify_all();
+    }
+
+    std::vector<T> WaitFor(size_t count) {
+        std::unique_lock lock(_mutex);
+        _cv.wait_for(lock, std::chrono::seconds(5), [&] { return _items.size() >= count; });
+        return _items;
+    }
+};
+
+class ChangeStreamTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition), decltype(DeptTableDefinition)> db = Database{
+        "test_database.db", UserTableDefinition, DeptTableDefinition
+    };
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+    Table<decltype(DeptTableDefinition)> &deptTable = db.GetTable<decltype(DeptTableDefinition)>();
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試同一交易的變更合併為一個批次，ROLLBACK 的變更不會送出
+TEST_F(ChangeStreamTest, BatchPerTransaction) {
+    ChangeCollector<ChangeBatch> collector;
+    auto stream = db.Subscribe([&collector](const ChangeBatch &batch) { collector.Add(batch); });
+
+    db.CreateTransaction([this] {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Alice", 25);
+        deptTable.Insert<decltype(DeptColumn), decltype(NameColumn)>("IT", "Alice");
+    });
+    EXPECT_ANY_THROW(db.CreateTransaction([this] {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Temp", 1);
+        throw std::runtime_error("Force rollback");
+    }));
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Bob", 30);
+
+    auto batches = collector.WaitFor(2);
+    ASSERT_EQ(batches.size(), 2);
+    ASSERT_EQ(batches[0].events.size(), 2);
+    EXPECT_EQ(batches[0].events[0].table, "name");
+    EXPECT_EQ(batches[0].events[0].operation, ChangeOperation::INSERT);
+    EXPECT_EQ(batches[0].events[1].table, "departments");
+    ASSERT_EQ(batches[1].events.size(), 1);
+    EXPECT_EQ(batches[1].events[0].rowId, 2);
+    EXPECT_EQ(batches[1].sequence, batches[0].sequence + 1);
+}
+
+// 測試只訂閱指定的資料表
+TEST_F(ChangeStreamTest, TableFilter) {
+    ChangeCollector<ChangeBatch> collector;
+    auto stream = db.Subscribe([&collector](const ChangeBatch &batch) { collector.Add(batch); },
+                               ChangeStreamOptions{.tables = {"departments"}});
+
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Alice", 25);
+    deptTable.Insert<decltype(DeptColumn), decltype(NameColumn)>("IT", "Alice");
+
+    auto batches = collector.WaitFor(1);
+    stream.reset();
+    ASSERT_EQ(batches.size(), 1);
+    ASSERT_EQ(batches[0].events.size(), 1);
+    EXPECT_EQ(batches[0].events[0].table, "departments");
+}
+
+// 測試 Table::Subscribe 回傳強型別的變更前後資料
+TEST_F(ChangeStreamTest, TypedTableSubscription) {
+    using Row = std::tuple<std::string, int, double>;
+    ChangeCollector<RowChange<Row> > collector;
+    auto stream = userTable.Subscribe([&collector](const std::vector<RowChange<Row> > &changes) {
+        for (const auto &change: changes) {
+            collector.Add(change);
+        }
+    });
+
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+    userTable.Update<decltype(AgeColumn)>(26).Where(userTable[NameColumn] == "Alice"_expr).Execute();
+    userTable.Delete().Where(userTable[NameColumn] == "Alice"_expr).Execute();
+
+    auto changes = collector.WaitFor(3);
+    ASSERT_EQ(changes.size(), 3);
+    EXPECT_EQ(changes[0].operation, ChangeOperation::INSERT);
+    EXPECT_EQ(changes[1].operation, ChangeOperation::UPDATE);
+    EXPECT_EQ(changes[2].operation, ChangeOperation::DELETE);
+    EXPECT_EQ(changes[2].rowId, changes[0].rowId);
+#ifdef SQLITE_ENABLE_PREUPDATE_HOOK
+    EXPECT_FALSE(changes[0].oldRow.has_value());
+    EXPECT_EQ(changes[0].newRow, (Row{"Alice", 25, 85.5}));
+    EXPECT_EQ(std::get<1>(*changes[1].oldRow), 25);
+    EXPECT_EQ(std::get<1>(*changes[1].newRow), 26);
+    EXPECT_EQ(changes[2].oldRow, (Row{"Alice", 26, 85.5}));
+    EXPECT_FALSE(changes[2].newRow.has_value());
+#endif
+}
+
+// 測試消費端過慢時 ring buffer 丟棄最舊的批次，寫入端不會被阻塞
+TEST_F(ChangeStreamTest, OverflowDropsOldest) {
+    std::mutex gate;
+    std::unique_lock blocked(gate);
+    std::vector<uint64_t> sequences;
+    auto stream = db.Subscribe([&](const ChangeBatch &batch) {
+        std::lock_guard wait(gate);
+        sequences.push_back(batch.sequence);
+    }, ChangeStreamOptions{.capacity = 1});
+
+    for (int i = 0; i < 5; ++i) {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("User", i);
+    }
+    auto stats = stream->Stats();
+    blocked.unlock();
+    stream.reset();
+
+    EXPECT_EQ(stats.committed, 5);
+    EXPECT_GE(stats.dropped, 3);
+    EXPECT_EQ(sequences.size() + stats.dropped, 5);
+    EXPECT_EQ(sequences.back(), 5);
+}
+
+// 測試 COMMIT 因 SQLITE_BUSY 失敗時不會送出批次，重新 COMMIT 成功後才送出
+TEST_F(ChangeStreamTest, FailedCommitNotPublished) {
+    ChangeCollector<ChangeBatch> collector;
+    SQLiteWrapper writer("test_database.db", OpenOptions{});
+    ChangeStream stream(writer, [&collector](const ChangeBatch &batch) { collector.Add(batch); });
+
+    // 另一個連線持有 SHARED 鎖，COMMIT 無法取得 EXCLUSIVE 鎖
+    sqlite3 *pReader = nullptr;
+    ASSERT_EQ(sqlite3_open("test_database.db", &pReader), SQLITE_OK);
+    ASSERT_EQ(sqlite3_exec(pReader, "BEGIN; SELECT count(*) FROM name;", nullptr, nullptr, nullptr), SQLITE_OK);
+
+    writer.Execute("BEGIN;");
+    writer.Execute("INSERT INTO name (name, age) VALUES (?, ?);", std::string("Alice"), 25);
+    EXPECT_ANY_THROW(writer.Execute("COMMIT;"));
+    EXPECT_EQ(stream.Stats().committed, 0);
+
+    ASSERT_EQ(sqlite3_exec(pReader, "COMMIT;", nullptr, nullptr, nullptr), SQLITE_OK);
+    sqlite3_close(pReader);
+    writer.Execute("COMMIT;");
+
+    auto batches = collector.WaitFor(1);
+    ASSERT_EQ(batches.size(), 1);
+    ASSERT_EQ(batches[0].events.size(), 1);
+    EXPECT_EQ(batches[0].events[0].rowId, 1);
+    EXPECT_EQ(stream.Stats().committed, 1);
+}
+
+// 測試 committed 偵測不佔用使用者的 trace callback，RETURNING 的寫入在結果釋放後送出
+TEST_F(ChangeStreamTest, CommittedKeepsUserTrace) {
+    ChangeCollector<ChangeBatch> collector;
+    SQLiteWrapper writer("test_database.db", OpenOptions{});
+    int traced = 0;
+    sqlite3_trace_v2(writer._dbPtr.get(), SQLITE_TRACE_STMT, [](unsigned, void *pCount, void *, void *) {
+        ++*static_cast<int *>(pCount);
+        return 0;
+    }, &traced);
+    ChangeStream stream(writer, [&collector](const ChangeBatch &batch) { collector.Add(batch); });
+
+    writer.Execute("INSERT INTO name (name, age) VALUES (?, ?);", std::string("Alice"), 25);
+    {
+        auto ids = writer.Query<int64_t>("INSERT INTO name (name, age) VALUES ('Bob', 30) RETURNING rowid;").ToVector();
+        ASSERT_EQ(ids.size(), 1);
+    }
+
+    auto batches = collector.WaitFor(2);
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[1].events[0].rowId, 2);
+    EXPECT_EQ(traced, 2);
+}
+
+// 測試消費端的例外計入統計並交給 onError，不影響後續批次
+TEST_F(ChangeStreamTest, ConsumerErrorsCounted) {
+    ChangeCollector<std::string> errors;
+    ChangeCollector<uint64_t> sequences;
+    auto stream = db.Subscribe([&sequences](const ChangeBatch &batch) {
+        if (batch.sequence == 1) {
+            throw std::runtime_error("Consumer failed");
+        }
+        sequences.Add(batch.sequence);
+    }, ChangeStreamOptions{
+        .onError = [&errors](std::exception_ptr pException) {
+            try {
+                std::rethrow_exception(pException);
+            } catch (const std::exception &exception) {
+                errors.Add(exception.what());
+            }
+        }
+    });
+
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Alice", 25);
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Bob", 30);
+
+    ASSERT_EQ(sequences.WaitFor(1).size(), 1);
+    EXPECT_EQ(stream->Stats().failed, 1);
+    stream.reset();
+    auto messages = errors.WaitFor(1);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0], "Consumer failed");
+}
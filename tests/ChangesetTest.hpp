@@ -0,0 +1,167 @@
+#pragma once
+#include "Common.hpp"
+
+#ifdef SQLITE_ENABLE_SESSION
+// ============ Session 變更集測試 ============
+
+class ChangesetTest : public ::testing::Test {
+protected:
+    Column<"id", DataType::INTEGER, ColumnPrimaryKey<> > IdColumn;
+    decltype(MakeTableDefinition<"accounts">(
+        std::make_tuple(IdColumn, NameColumn, AgeColumn)
+    )) AccountsDefinition = MakeTableDefinition<"accounts">(
+        std::make_tuple(IdColumn, NameColumn, AgeColumn)
+    );
+
+    Database<decltype(AccountsDefinition)> db = Database{"test_database.db", AccountsDefinition};
+    Database<decltype(AccountsDefinition)> replica = Database{"test_replica.db", AccountsDefinition};
+    Table<decltype(AccountsDefinition)> &accountTable = db.GetTable<decltype(AccountsDefinition)>();
+    Table<decltype(AccountsDefinition)> &replicaTable = replica.GetTable<decltype(AccountsDefinition)>();
+
+    void TearDown() override {
+        std::remove("test_database.db");
+        std::remove("test_replica.db");
+    }
+
+    auto ReplicaRows() {
+        return replicaTable.Select(replicaTable[IdColumn], replicaTable[NameColumn], replicaTable[AgeColumn])
+                .OrderBy(replicaTable[IdColumn])
+                .Results().ToVector();
+    }
+};
+
+// 測試記錄 INSERT/UPDATE/DELETE 並套用到另一個資料庫
+TEST_F(ChangesetTest, RecordAndApply) {
+    accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(1, "Alice", 25);
+    replicaTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(1, "Alice", 25);
+
+    Changeset changeset;
+    {
+        auto recorder = db.RecordChanges();
+        EXPECT_TRUE(recorder.IsEmpty());
+        accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(2, "Bob", 30);
+        accountTable.Update<decltype(AgeColumn)>(26).Where(accountTable[IdColumn] == 1_expr).Execute();
+        accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(3, "Temp", 1);
+        accountTable.Delete().Where(accountTable[IdColumn] == 3_expr).Execute();
+        EXPECT_FALSE(recorder.IsEmpty());
+        changeset = recorder.GetChangeset();
+    }
+    replica.ApplyChangeset(changeset);
+
+    auto rows = ReplicaRows();
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(rows[0], std::make_tuple(1, std::string("Alice"), 26));
+    EXPECT_EQ(rows[1], std::make_tuple(2, std::string("Bob"), 30));
+}
+
+// 測試衝突處理策略
+TEST_F(ChangesetTest, ConflictPolicy) {
+    replicaTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(1, "Local", 99);
+
+    Changeset changeset;
+    {
+        auto recorder = db.RecordChanges<decltype(AccountsDefinition)>();
+        accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(1, "Alice", 25);
+        accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(2, "Bob", 30);
+        changeset = recorder.GetChangeset();
+    }
+
+    // ABORT 時整個變更集都不會套用
+    EXPECT_THROW(replica.ApplyChangeset(changeset, ConflictCause::ABORT), std::runtime_error);
+    EXPECT_EQ(ReplicaRows().size(), 1);
+
+    replica.ApplyChangeset(changeset, ConflictCause::IGNORE);
+    auto rows = ReplicaRows();
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(std::get<1>(rows[0]), "Local");
+
+    replica.ApplyChangeset(changeset, ConflictCause::REPLACE);
+    rows = ReplicaRows();
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(std::get<1>(rows[0]), "Alice");
+}
+
+// 測試反轉變更集可還原變更
+TEST_F(ChangesetTest, InvertChangeset) {
+    accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(1, "Alice", 25);
+
+    Changeset changeset;
+    {
+        auto recorder = db.RecordChanges();
+        accountTable.Update<decltype(AgeColumn)>(40).Where(accountTable[IdColumn] == 1_expr).Execute();
+        accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(2, "Bob", 30);
+        changeset = recorder.GetChangeset();
+        EXPECT_LT(recorder.GetPatchset().size(), changeset.size());
+    }
+    db.ApplyChangeset(InvertChangeset(changeset));
+
+    auto rows = accountTable.Select(accountTable[IdColumn], accountTable[AgeColumn]).Results().ToVector();
+    ASSERT_EQ(rows.size(), 1);
+    EXPECT_EQ(std::get<1>(rows[0]), 25);
+}
+
+// 測試變更記錄、ChangeStream 與多個記錄器可以同時使用同一個連線
+TEST_F(ChangesetTest, CoexistsWithChangeStream) {
+    std::atomic<size_t> events = 0;
+    auto stream = db.Subscribe([&events](const ChangeBatch &batch) { events += batch.events.size(); });
+
+    Changeset changeset;
+    Changeset updates;
+    {
+        auto recorder = db.RecordChanges();
+        accountTable.Insert<decltype(IdColumn), decltype(NameColumn), decltype(AgeColumn)>(1, "Alice", 25);
+        auto updateRecorder = db.RecordChanges<decltype(AccountsDefinition)>();
+        accountTable.Update<decltype(AgeColumn)>(26).Where(accountTable[IdColumn] == 1_expr).Execute();
+        changeset = recorder.GetChangeset();
+        updates = updateRecorder.GetChangeset();
+    }
+    stream.reset();
+    EXPECT_EQ(events, 2);
+
+    replica.ApplyChangeset(changeset);
+    EXPECT_EQ(ReplicaRows(), (std::vector{std::make_tuple(1, std::string("Alice"), 26)}));
+
+    // 第二個記錄器只看到 UPDATE
+    db.ApplyChangeset(InvertChangeset(updates));
+    auto ages = accountTable.Select(accountTable[AgeColumn]).Results().ToVector();
+    EXPECT_EQ(ages, (std::vector{std::make_tuple(25)}));
+}
+
+// 測試產生的變更集與 session 擴充的格式相同
+TEST_F(ChangesetTest, MatchesSessionFormat) {
+    SQLiteWrapper writer("test_database.db", OpenOptions{});
+    sqlite3 *pReference = nullptr;
+    ASSERT_EQ(sqlite3_open("test_replica.db", &pReference), SQLITE_OK);
+    auto take = [](int size, void *pBuffer) {
+        auto pBytes = static_cast<const uint8_t *>(pBuffer);
+        Changeset bytes = pBytes ? Changeset(pBytes, pBytes + size) : Changeset{};
+        sqlite3_free(pBuffer);
+        return bytes;
+    };
+
+    for (auto sql: {
+             "INSERT INTO accounts (id, name, age) VALUES (1, 'Alice', NULL);",
+             "UPDATE accounts SET age = 26, name = 'Alicia' WHERE id = 1;",
+             "UPDATE accounts SET age = 26 WHERE id = 1;",
+             "UPDATE accounts SET id = 2 WHERE id = 1;",
+             "DELETE FROM accounts WHERE id = 2;",
+         }) {
+        ChangeRecorder recorder(writer, {"accounts"});
+        sqlite3_session *pSession = nullptr;
+        ASSERT_EQ(sqlite3session_create(pReference, "main", &pSession), SQLITE_OK);
+        ASSERT_EQ(sqlite3session_attach(pSession, "accounts"), SQLITE_OK);
+        writer.Execute(sql);
+        ASSERT_EQ(sqlite3_exec(pReference, sql, nullptr, nullptr, nullptr), SQLITE_OK);
+
+        int size = 0;
+        void *pBuffer = nullptr;
+        ASSERT_EQ(sqlite3session_changeset(pSession, &size, &pBuffer), SQLITE_OK);
+        EXPECT_EQ(recorder.GetChangeset(), take(size, pBuffer)) << sql;
+        ASSERT_EQ(sqlite3session_patchset(pSession, &size, &pBuffer), SQLITE_OK);
+        EXPECT_EQ(recorder.GetPatchset(), take(size, pBuffer)) << sql;
+        EXPECT_EQ(recorder.IsEmpty(), sqlite3session_isempty(pSession) != 0) << sql;
+        sqlite3session_delete(pSession);
+    }
+    sqlite3_close(pReference);
+}
+#endif
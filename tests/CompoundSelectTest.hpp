@@ -0,0 +1,109 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ 複合查詢 (UNION/INTERSECT/EXCEPT) 測試 ============
+
+class CompoundSelectTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition), decltype(DeptTableDefinition)> db =
+            Database{"test_database.db", UserTableDefinition, DeptTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+    Table<decltype(DeptTableDefinition)> &deptTable = db.GetTable<decltype(DeptTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+
+        deptTable.Insert<decltype(DeptColumn), decltype(NameColumn)>("HR", "Bob");
+        deptTable.Insert<decltype(DeptColumn), decltype(NameColumn)>("IT", "Charlie");
+        deptTable.Insert<decltype(DeptColumn), decltype(NameColumn)>("IT", "Eve");
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試 UNION 去除重複並排序整個結果
+TEST_F(CompoundSelectTest, UnionOrderBy) {
+    auto results = userTable.Select(userTable[NameColumn])
+            .Union(deptTable.Select(deptTable[NameColumn]))
+            .OrderBy(userTable[NameColumn], OrderType::DESC)
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(std::get<0>(results[0]), "Eve");
+    EXPECT_EQ(std::get<0>(results[1]), "Charlie");
+    EXPECT_EQ(std::get<0>(results[2]), "Bob");
+    EXPECT_EQ(std::get<0>(results[3]), "Alice");
+}
+
+// 測試 UNION ALL 保留重複，LIMIT 套用在整個結果
+TEST_F(CompoundSelectTest, UnionAllLimit) {
+    auto query = userTable.Select(userTable[NameColumn]).UnionAll(deptTable.Select(deptTable[NameColumn]));
+    EXPECT_EQ(query.Count(), 6);
+
+    // Alice, Bob, Bob, Charlie, Charlie, Eve
+    auto page = query.OrderBy(userTable[NameColumn]);
+    page.LimitOffset(2, 3);
+    auto results = page.Results().ToVector();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Charlie");
+    EXPECT_EQ(std::get<0>(results[1]), "Charlie");
+}
+
+// 測試帶 ORDER BY/LIMIT 的運算元只套用在自己身上
+TEST_F(CompoundSelectTest, OperandWithOrderByAndLimit) {
+    auto youngest = userTable.Select(userTable[NameColumn]).OrderBy(userTable[AgeColumn], OrderType::ASC);
+    youngest.LimitOffset(1);
+    auto oldest = userTable.Select(userTable[NameColumn]).OrderBy(userTable[AgeColumn], OrderType::DESC);
+    oldest.LimitOffset(1);
+
+    // 運算元被包成子查詢，結果欄位只剩欄位名稱
+    auto results = youngest.UnionAll(oldest).OrderBy(NameColumn).Results().ToVector();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Alice");
+    EXPECT_EQ(std::get<0>(results[1]), "Charlie");
+}
+
+// 測試右邊的複合查詢保留自己的結合順序：A EXCEPT (B UNION C)
+TEST_F(CompoundSelectTest, NestedCompoundOperand) {
+    auto results = userTable.Select(userTable[NameColumn])
+            .Except(deptTable.Select(deptTable[NameColumn]).Where(deptTable[DeptColumn] == "HR"_expr)
+                .Union(deptTable.Select(deptTable[NameColumn]).Where(deptTable[DeptColumn] == "IT"_expr)))
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<0>(results[0]), "Alice");
+}
+
+// 測試 INTERSECT 與 EXCEPT，參數依各 SELECT 的順序綁定
+TEST_F(CompoundSelectTest, IntersectExcept) {
+    auto common = userTable.Select(userTable[NameColumn]).Where(userTable[AgeColumn] > 26_expr)
+            .Intersect(deptTable.Select(deptTable[NameColumn]).Where(deptTable[DeptColumn] == "IT"_expr))
+            .Results().ToVector();
+    ASSERT_EQ(common.size(), 1);
+    EXPECT_EQ(std::get<0>(common[0]), "Charlie");
+
+    auto onlyUsers = userTable.Select(userTable[NameColumn])
+            .Except(deptTable.Select(deptTable[NameColumn]))
+            .Results().ToVector();
+    ASSERT_EQ(onlyUsers.size(), 1);
+    EXPECT_EQ(std::get<0>(onlyUsers[0]), "Alice");
+}
+
+// 測試多個運算子由左至右結合，以及作為 IN 的子查詢
+TEST_F(CompoundSelectTest, ChainedAndSubQuery) {
+    auto names = userTable.Select(userTable[NameColumn])
+            .UnionAll(deptTable.Select(deptTable[NameColumn]))
+            .Except(deptTable.Select(deptTable[NameColumn]).Where(deptTable[DeptColumn] == "HR"_expr));
+    EXPECT_EQ(names.Count(), 3);
+    EXPECT_TRUE(names.Exists());
+
+    auto results = userTable.Select(userTable[AgeColumn])
+            .Where(In(userTable[NameColumn], names))
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), 25);
+    EXPECT_EQ(std::get<0>(results[1]), 35);
+}
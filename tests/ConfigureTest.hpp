@@ -0,0 +1,126 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include "Common.hpp"
+
+// ============ 全域配置與 lookaside 測試 ============
+
+// 統計呼叫次數並轉交給 ThreadCachingAllocator
+struct CountingAllocator {
+    ThreadCachingAllocator allocator;
+    std::atomic<int> allocations = 0;
+
+    void *Allocate(int size) {
+        ++allocations;
+        return allocator.Allocate(size);
+    }
+
+    void *Reallocate(void *p, int size) {
+        return allocator.Reallocate(p, size);
+    }
+
+    void Free(void *p) {
+        allocator.Free(p);
+    }
+
+    int Size(void *p) {
+        return allocator.Size(p);
+    }
+
+    int RoundUp(int size) {
+        return allocator.RoundUp(size);
+    }
+};
+
+class ConfigureTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        // 恢復預設配置器並停用 page cache 緩衝區，避免影響其他測試
+        Configure(EngineConfig{});
+        std::remove("test_database.db");
+        std::remove("test_worker.db");
+    }
+
+    static void Exercise(const std::string &path, int rows) {
+        Database db{path, UserTableDefinition};
+        auto &userTable = db.GetTable<decltype(UserTableDefinition)>();
+        db.CreateTransaction([&] {
+            for (int i = 0; i < rows; ++i) {
+                userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("User" + std::to_string(i), i);
+            }
+        });
+        EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), rows);
+    }
+};
+
+// 測試 ThreadCachingAllocator 的取整與重複使用
+TEST_F(ConfigureTest, ThreadCachingAllocator) {
+    ThreadCachingAllocator allocator;
+    EXPECT_EQ(allocator.RoundUp(1), 16);
+    EXPECT_EQ(allocator.RoundUp(100), 128);
+    EXPECT_EQ(allocator.RoundUp(5000), 5000);
+
+    auto p = allocator.Allocate(100);
+    EXPECT_EQ(allocator.Size(p), 128);
+    std::memset(p, 0xAB, 100);
+    allocator.Free(p);
+    EXPECT_EQ(allocator.Allocate(120), p);
+
+    auto grown = static_cast<uint8_t *>(allocator.Reallocate(p, 1000));
+    EXPECT_EQ(grown[99], 0xAB);
+    EXPECT_EQ(allocator.Size(grown), 1024);
+    allocator.Free(grown);
+}
+
+// 測試以自訂配置器、預先配置的 page cache 與 lookaside 執行
+TEST_F(ConfigureTest, CustomAllocatorAndPageCache) {
+    static CountingAllocator allocator;
+    Configure(EngineConfig{
+        .memMethods = UseAllocator(allocator),
+        .pageCache = PageCacheConfig{.pageSize = 4096, .slots = 64},
+        .lookaside = LookasideConfig{.slotSize = 512, .slots = 64}
+    });
+
+    Exercise("test_database.db", 1000);
+    std::thread worker([] { Exercise("test_worker.db", 200); });
+    worker.join();
+
+    EXPECT_GT(allocator.allocations.load(), 0);
+    int current = 0;
+    int highwater = 0;
+    sqlite3_status(SQLITE_STATUS_PAGECACHE_USED, &current, &highwater, 0);
+    EXPECT_GT(highwater, 0);
+}
+
+// 測試未指定 memMethods 時恢復編譯時的預設配置器
+TEST_F(ConfigureTest, RestoreDefaultAllocator) {
+    static CountingAllocator allocator;
+    Configure(EngineConfig{.memMethods = UseAllocator(allocator), .pageCache = {}, .lookaside = {}});
+    Exercise("test_database.db", 10);
+    EXPECT_GT(allocator.allocations.load(), 0);
+
+    Configure(EngineConfig{});
+    auto allocations = allocator.allocations.load();
+    Exercise("test_worker.db", 10);
+    EXPECT_EQ(allocator.allocations.load(), allocations);
+}
+
+// 測試每個連線的 lookaside 設定
+TEST_F(ConfigureTest, PerConnectionLookaside) {
+    if (sqlite3_compileoption_used("OMIT_LOOKASIDE")) {
+        GTEST_SKIP() << "SQLite was compiled with SQLITE_OMIT_LOOKASIDE";
+    }
+    auto lookasideHits = [](const std::optional<LookasideConfig> &lookaside) {
+        SQLiteWrapper sqlite(":memory:", OpenOptions{.lookaside = lookaside});
+        sqlite.Execute("CREATE TABLE IF NOT EXISTS t (a INTEGER, b TEXT);");
+        for (int i = 0; i < 50; ++i) {
+            sqlite.Execute("INSERT INTO t VALUES (?, ?);", i, std::to_string(i));
+        }
+        int current = 0;
+        int highwater = 0;
+        sqlite3_db_status(sqlite._dbPtr.get(), SQLITE_DBSTATUS_LOOKASIDE_HIT, &current, &highwater, 0);
+        return highwater;
+    };
+    EXPECT_GT(lookasideHits(LookasideConfig{.slotSize = 256, .slots = 200}), 0);
+    EXPECT_EQ(lookasideHits(LookasideConfig{.slotSize = 0, .slots = 0}), 0);
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <span>
+#include "Common.hpp"
+
+// ============ 容器虛擬表測試 ============
+
+class ContainerTableTest : public ::testing::Test {
+protected:
+    Column<"bonus", DataType::INTEGER> BonusColumn;
+
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("David", 40, 88.0);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試以 span 作為 InnerJoin 的來源
+TEST_F(ContainerTableTest, InnerJoinSpan) {
+    std::vector<std::string> names = {"Bob", "David", "Nobody"};
+    auto wanted = db.AttachContainer<"wanted_names">(std::span<const std::string>(names), NameColumn);
+
+    auto results = userTable.InnerJoin(wanted, userTable[NameColumn] == wanted[NameColumn])
+            .Select(userTable[NameColumn], userTable[AgeColumn])
+            .OrderBy(userTable[AgeColumn], OrderType::ASC)
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "David");
+}
+
+// 測試多欄位的 tuple 容器與 LeftJoin
+TEST_F(ContainerTableTest, LeftJoinTuples) {
+    std::vector<std::tuple<std::string, int> > bonuses = {{"Alice", 100}, {"Charlie", 300}, {"Alice", 50}};
+    auto bonusTable = db.AttachContainer<"bonuses">(bonuses, NameColumn, BonusColumn);
+
+    auto results = userTable.LeftJoin(bonusTable, userTable[NameColumn] == bonusTable[NameColumn])
+            .Select(userTable[NameColumn], Total(bonusTable[BonusColumn]))
+            .GroupBy(userTable[NameColumn])
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(std::get<0>(results[0]), "Alice");
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 150);
+    EXPECT_EQ(std::get<0>(results[1]), "Bob");
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 0);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[2]), 300);
+}
+
+// 測試 IN (SELECT ...) 與直接查詢虛擬表
+TEST_F(ContainerTableTest, InSubQuery) {
+    std::vector<int64_t> ages = {30, 40, 50};
+    auto ageTable = db.AttachContainer<"wanted_ages">(ages, AgeColumn);
+
+    EXPECT_EQ(ageTable.Select(ageTable[AgeColumn]).Count(), 3);
+    auto results = userTable.Select(userTable[NameColumn])
+            .Where(In(userTable[AgeColumn], ageTable.Select(ageTable[AgeColumn])))
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "David");
+}
+
+// 測試等值條件直接查找，以及重複值都會回傳
+TEST_F(ContainerTableTest, EqualityLookup) {
+    std::vector<std::tuple<int, std::string> > rows;
+    for (int i = 0; i < 10000; ++i) {
+        rows.emplace_back(i % 5000, "row" + std::to_string(i));
+    }
+    auto table = db.AttachContainer<"numbers">(rows, AgeColumn, NameColumn);
+
+    auto results = table.Select(table[NameColumn]).Where(table[AgeColumn] == 4999_expr).Results().ToVector();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "row4999");
+    EXPECT_EQ(std::get<0>(results[1]), "row9999");
+    EXPECT_EQ(table.Select(table[AgeColumn]).Where(table[NameColumn] == "row42"_expr).Count(), 1);
+}
+
+// 測試重新綁定資料
+TEST_F(ContainerTableTest, Rebind) {
+    std::vector<std::string> first = {"Alice"};
+    std::vector<std::string> second = {"Bob", "Charlie"};
+    auto wanted = db.AttachContainer<"wanted_names">(first, NameColumn);
+    auto query = [&] {
+        return userTable.InnerJoin(wanted, userTable[NameColumn] == wanted[NameColumn])
+                .Select(userTable[AgeColumn]).Count();
+    };
+
+    EXPECT_EQ(query(), 1);
+    wanted.Bind(second);
+    EXPECT_EQ(wanted.Size(), 2);
+    EXPECT_EQ(query(), 2);
+}
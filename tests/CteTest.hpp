@@ -0,0 +1,127 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ CTE (WITH / WITH RECURSIVE) 測試 ============
+
+inline Column<"manager", DataType::TEXT> ManagerColumn;
+inline Column<"level", DataType::INTEGER> LevelColumn;
+inline auto EmployeeTableDefinition = MakeTableDefinition<"employees">(std::make_tuple(NameColumn, ManagerColumn));
+
+class CteTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition), decltype(EmployeeTableDefinition)> db =
+            Database{"test_database.db", UserTableDefinition, EmployeeTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+    Table<decltype(EmployeeTableDefinition)> &employees = db.GetTable<decltype(EmployeeTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("David", 40, 88.0);
+
+        employees.Insert<decltype(NameColumn), decltype(ManagerColumn)>("Alice", "CEO");
+        employees.Insert<decltype(NameColumn), decltype(ManagerColumn)>("Bob", "CEO");
+        employees.Insert<decltype(NameColumn), decltype(ManagerColumn)>("Carol", "Alice");
+        employees.Insert<decltype(NameColumn), decltype(ManagerColumn)>("Dave", "Carol");
+        employees.Insert<decltype(NameColumn), decltype(ManagerColumn)>("Eve", "Bob");
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+
+    // Alice 與其所有下屬；CTE 欄位沒有型別親和性，層級以整數參數綁定
+    auto AliceChain() {
+        return db.WithRecursive<"chain">(
+            employees.Select(employees[NameColumn], MakeParamExpr(int64_t{0})).Where(employees[NameColumn] == "Alice"_expr),
+            [this](const auto &chain) {
+                return employees.InnerJoin(chain, employees[ManagerColumn] == chain[NameColumn])
+                        .Select(employees[NameColumn], chain[LevelColumn] + MakeParamExpr(int64_t{1}));
+            },
+            NameColumn, LevelColumn);
+    }
+};
+
+// 測試以 CTE 作為主要來源
+TEST_F(CteTest, SelectFromCte) {
+    auto older = db.With<"older">(userTable.Select(userTable[NameColumn], userTable[AgeColumn])
+        .Where(userTable[AgeColumn] > 28_expr));
+    auto query = older.Select(older[NameColumn]).Where(older[AgeColumn] < 40_expr);
+
+    EXPECT_EQ(query.StatementSql().rfind("WITH older(name, age) AS (SELECT ", 0), 0);
+    auto results = query.Results().ToVector();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "Charlie");
+    EXPECT_EQ(query.Count(), 2);
+}
+
+// 測試 Join CTE 時 WITH 的參數排在其他參數之前
+TEST_F(CteTest, JoinCte) {
+    auto older = db.With<"older">(userTable.Select(userTable[NameColumn], userTable[AgeColumn])
+        .Where(userTable[AgeColumn] > 28_expr));
+    auto results = userTable.InnerJoin(older, userTable[NameColumn] == older[NameColumn])
+            .Select(userTable[NameColumn], userTable[ScoreColumn])
+            .Where(userTable[ScoreColumn] > 80_expr)
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "David");
+}
+
+// 測試兩個 CTE 互相 Join
+TEST_F(CteTest, MultipleCtes) {
+    auto older = db.With<"older">(userTable.Select(userTable[NameColumn]).Where(userTable[AgeColumn] > 28_expr));
+    auto good = db.With<"good">(userTable.Select(userTable[NameColumn]).Where(userTable[ScoreColumn] > 86_expr));
+    auto results = older.InnerJoin(good, older[NameColumn] == good[NameColumn])
+            .Select(older[NameColumn])
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "David");
+}
+
+// 測試遞迴走訪組織階層
+TEST_F(CteTest, RecursiveHierarchy) {
+    auto chain = AliceChain();
+    auto query = chain.Select(chain[NameColumn], chain[LevelColumn]).OrderBy(chain[LevelColumn], OrderType::ASC);
+
+    EXPECT_EQ(query.StatementSql().rfind("WITH RECURSIVE chain(name, level) AS (", 0), 0);
+    auto results = query.Results().ToVector();
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(std::get<0>(results[0]), "Alice");
+    EXPECT_EQ(std::get<1>(results[0]), 0);
+    EXPECT_EQ(std::get<0>(results[1]), "Carol");
+    EXPECT_EQ(std::get<1>(results[1]), 1);
+    EXPECT_EQ(std::get<0>(results[2]), "Dave");
+    EXPECT_EQ(std::get<1>(results[2]), 2);
+}
+
+// 測試 CTE 的子查詢用於 IN
+TEST_F(CteTest, RecursiveInSubQuery) {
+    auto chain = AliceChain();
+    auto results = employees.Select(employees[NameColumn])
+            .Where(!In(employees[NameColumn], chain.Select(chain[NameColumn])))
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "Eve");
+}
+
+// 測試帶 WITH 的 SELECT 作為複合查詢的運算元，兩邊的參數依序綁定
+TEST_F(CteTest, CteInCompoundSelect) {
+    auto older = db.With<"older">(userTable.Select(userTable[NameColumn], userTable[AgeColumn])
+        .Where(userTable[AgeColumn] > 32_expr));
+    auto results = userTable.Select(userTable[NameColumn]).Where(userTable[AgeColumn] < 28_expr)
+            .UnionAll(older.Select(older[NameColumn]).Where(older[AgeColumn] < 40_expr))
+            .OrderBy(NameColumn)
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Alice");
+    EXPECT_EQ(std::get<0>(results[1]), "Charlie");
+}
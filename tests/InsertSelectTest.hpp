@@ -0,0 +1,110 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ INSERT ... SELECT 與 UPDATE ... FROM 測試 ============
+
+class InsertSelectTest : public ::testing::Test {
+protected:
+    decltype(MakeTableDefinition<"archive">(std::make_tuple(NameColumn, AgeColumn, ScoreColumn)))
+    ArchiveTableDefinition = MakeTableDefinition<"archive">(std::make_tuple(NameColumn, AgeColumn, ScoreColumn));
+
+    Database<decltype(UserTableDefinition), decltype(ArchiveTableDefinition)> db = Database{
+        "test_database.db", UserTableDefinition, ArchiveTableDefinition
+    };
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+    Table<decltype(ArchiveTableDefinition)> &archiveTable = db.GetTable<decltype(ArchiveTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試 INSERT ... SELECT 搭配 WHERE 與參數
+TEST_F(InsertSelectTest, InsertFromSelect) {
+    archiveTable.InsertFrom<decltype(NameColumn), decltype(AgeColumn)>(
+        userTable.Select(userTable[NameColumn], userTable[AgeColumn])
+        .Where(userTable[AgeColumn] >= 30_expr)
+    );
+
+    auto results = archiveTable.Select(archiveTable[NameColumn], archiveTable[AgeColumn])
+            .OrderBy(archiveTable[AgeColumn])
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<1>(results[1]), 35);
+}
+
+// 測試 INSERT ... SELECT 使用運算式轉換資料
+TEST_F(InsertSelectTest, InsertFromSelectWithExpression) {
+    archiveTable.InsertFrom<decltype(NameColumn), decltype(ScoreColumn)>(
+        userTable.Select(userTable[NameColumn], userTable[ScoreColumn] * 2.0_expr)
+    );
+
+    auto results = archiveTable.Select(archiveTable[ScoreColumn])
+            .Where(archiveTable[NameColumn] == "Bob"_expr)
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[0]), 184.0);
+}
+
+// 測試以運算式更新欄位
+TEST_F(InsertSelectTest, UpdateWithSetExpression) {
+    userTable.Update(Set(userTable[AgeColumn], userTable[AgeColumn] + 1_expr))
+            .Where(userTable[NameColumn] == "Alice"_expr)
+            .Execute();
+
+    auto results = userTable.Select(userTable[AgeColumn])
+            .Where(userTable[NameColumn] == "Alice"_expr)
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<0>(results[0]), 26);
+}
+
+// 測試 UPDATE ... FROM
+TEST_F(InsertSelectTest, UpdateFromOtherTable) {
+    archiveTable.Insert<decltype(NameColumn), decltype(ScoreColumn)>("Alice", 60.0);
+    archiveTable.Insert<decltype(NameColumn), decltype(ScoreColumn)>("Charlie", 99.0);
+
+    userTable.Update(Set(userTable[ScoreColumn], archiveTable[ScoreColumn]))
+            .From(archiveTable)
+            .Where(userTable[NameColumn] == archiveTable[NameColumn])
+            .Execute();
+
+    auto results = userTable.Select(userTable[NameColumn], userTable[ScoreColumn])
+            .OrderBy(userTable[NameColumn])
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 60.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 92.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[2]), 99.0);
+}
+
+// 測試 UPDATE ... FROM CTE：WITH 子句與其參數排在 UPDATE 之前
+TEST_F(InsertSelectTest, UpdateFromCte) {
+    archiveTable.Insert<decltype(NameColumn), decltype(ScoreColumn)>("Alice", 40.0);
+    archiveTable.Insert<decltype(NameColumn), decltype(ScoreColumn)>("Alice", 70.0);
+    archiveTable.Insert<decltype(NameColumn), decltype(ScoreColumn)>("Charlie", 60.0);
+
+    auto best = db.With<"best">(archiveTable.Select(archiveTable[NameColumn], Max(archiveTable[ScoreColumn]))
+                                .Where(archiveTable[ScoreColumn] > 50.0_expr)
+                                .GroupBy(archiveTable[NameColumn]), NameColumn, ScoreColumn);
+
+    userTable.Update(Set(userTable[ScoreColumn], best[ScoreColumn] + 1.0_expr))
+            .From(best)
+            .Where(userTable[NameColumn] == best[NameColumn] && userTable[AgeColumn] < 30_expr)
+            .Execute();
+
+    auto results = userTable.Select(userTable[NameColumn], userTable[ScoreColumn])
+            .OrderBy(userTable[NameColumn])
+            .Results().ToVector();
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 71.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 92.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[2]), 78.5); // 35 歲，不符合條件
+}
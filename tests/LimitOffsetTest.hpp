@@ -167,3 +167,99 @@ TEST_F(LimitOffsetTest, LimitOffsetChainedAfterWhere) {
     EXPECT_EQ(std::get<1>(results[1]), 22);
 }
 
+// Keyset 分頁的排序鍵必須是 NOT NULL 欄位
+inline Column<"id", DataType::INTEGER, ColumnPrimaryKey<> > PagedIdColumn;
+inline Column<"name", DataType::TEXT, ColumnNotNull<> > PagedNameColumn;
+inline Column<"age", DataType::INTEGER, ColumnNotNull<> > PagedAgeColumn;
+inline Column<"score", DataType::REAL> PagedScoreColumn;
+inline auto PagedTableDefinition = MakeTableDefinition<"paged">(
+    std::make_tuple(PagedIdColumn, PagedNameColumn, PagedAgeColumn, PagedScoreColumn));
+
+template<typename Select, typename Key>
+concept CanPaginate = requires(const Select &select, Key key) { select.Paginate(1, key); };
+
+class KeysetPaginationTest : public ::testing::Test {
+protected:
+    Database<decltype(PagedTableDefinition)> db = Database{"test_database.db", PagedTableDefinition};
+    Table<decltype(PagedTableDefinition)> &pagedTable = db.GetTable<decltype(PagedTableDefinition)>();
+
+    void SetUp() override {
+        for (int i = 0; i < 10; i++) {
+            pagedTable.Insert<decltype(PagedNameColumn), decltype(PagedAgeColumn)>(
+                "User" + std::to_string(i),
+                20 + i
+            );
+        }
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試 Keyset 分頁走訪所有頁
+TEST_F(KeysetPaginationTest, WalksAllPages) {
+    auto paginator = pagedTable
+            .Select(pagedTable[PagedNameColumn], pagedTable[PagedAgeColumn])
+            .Paginate(3, pagedTable[PagedAgeColumn], pagedTable[PagedNameColumn]);
+
+    auto page1 = paginator.FetchPage();
+    ASSERT_EQ(page1.rows.size(), 3);
+    EXPECT_EQ(std::get<0>(page1.rows[0]), "User0");
+    EXPECT_EQ(std::get<1>(page1.rows[2]), 22);
+    ASSERT_TRUE(page1.next.has_value());
+
+    auto page2 = paginator.FetchPage(page1.next);
+    ASSERT_EQ(page2.rows.size(), 3);
+    EXPECT_EQ(std::get<0>(page2.rows[0]), "User3");
+
+    auto page3 = paginator.FetchPage(page2.next);
+    auto page4 = paginator.FetchPage(page3.next);
+    ASSERT_EQ(page4.rows.size(), 1);
+    EXPECT_EQ(std::get<0>(page4.rows[0]), "User9");
+    EXPECT_FALSE(page4.next.has_value());
+}
+
+// 測試 Keyset 分頁與 WHERE 及 DESC 組合
+TEST_F(KeysetPaginationTest, WithWhereDesc) {
+    auto paginator = pagedTable
+            .Select(pagedTable[PagedNameColumn])
+            .Where(pagedTable[PagedAgeColumn] < 25_expr)
+            .Paginate(2, OrderType::DESC, pagedTable[PagedAgeColumn]);
+
+    auto page1 = paginator.FetchPage();
+    ASSERT_EQ(page1.rows.size(), 2);
+    EXPECT_EQ(std::get<0>(page1.rows[0]), "User4");
+    EXPECT_EQ(std::get<0>(page1.rows[1]), "User3");
+
+    auto page2 = paginator.FetchPage(page1.next);
+    ASSERT_EQ(page2.rows.size(), 2);
+    EXPECT_EQ(std::get<0>(page2.rows[0]), "User2");
+
+    auto page3 = paginator.FetchPage(page2.next);
+    ASSERT_EQ(page3.rows.size(), 1);
+    EXPECT_EQ(std::get<0>(page3.rows[0]), "User0");
+    EXPECT_FALSE(page3.next.has_value());
+}
+
+// 測試剛好整頁時不會產生空的下一頁
+TEST_F(KeysetPaginationTest, ExactPage) {
+    auto paginator = pagedTable
+            .Select(pagedTable[PagedNameColumn])
+            .Paginate(10, pagedTable[PagedNameColumn]);
+
+    auto page = paginator.FetchPage();
+    EXPECT_EQ(page.rows.size(), 10);
+    EXPECT_FALSE(page.next.has_value());
+}
+
+// 測試可為 NULL 的排序鍵與 DISTINCT 在編譯期被拒絕
+TEST_F(KeysetPaginationTest, RejectsNullableKeysAndDistinct) {
+    using Select = decltype(pagedTable.Select(pagedTable[PagedNameColumn]));
+    using DistinctSelect = decltype(pagedTable.Select(pagedTable[PagedNameColumn]).Distinct());
+
+    static_assert(CanPaginate<Select, decltype(pagedTable[PagedNameColumn])>);
+    static_assert(CanPaginate<Select, decltype(pagedTable[PagedIdColumn])>);
+    static_assert(!CanPaginate<Select, decltype(pagedTable[PagedScoreColumn])>);
+    static_assert(!CanPaginate<DistinctSelect, decltype(pagedTable[PagedNameColumn])>);
+}
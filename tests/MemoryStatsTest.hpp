@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "Common.hpp"
+
+// ============ 記憶體統計測試 ============
+
+class MemoryStatsTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        db.CreateTransaction([this] {
+            for (int i = 0; i < 200; ++i) {
+                userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("User" + std::to_string(i), i);
+            }
+        });
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試回報行程與連線的記憶體使用量
+TEST_F(MemoryStatsTest, Snapshot) {
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 200);
+    auto stats = db.MemoryStats();
+
+    EXPECT_GT(stats.global.memoryUsed.current, 0);
+    EXPECT_GE(stats.global.memoryUsed.highwater, stats.global.memoryUsed.current);
+    EXPECT_GT(stats.global.mallocCount.current, 0);
+    EXPECT_GT(stats.connection.cacheUsed.current, 0);
+    EXPECT_GT(stats.connection.schemaUsed.current, 0);
+    EXPECT_GT(stats.connection.cacheHit.current + stats.connection.cacheMiss.current, 0);
+    EXPECT_GT(stats.connection.cacheWrite.current, 0);
+}
+
+// 測試 reset 後累計計數歸零
+TEST_F(MemoryStatsTest, Reset) {
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 200);
+    db.MemoryStats(true);
+    auto stats = db.MemoryStats();
+    EXPECT_EQ(stats.connection.cacheHit.current, 0);
+    EXPECT_EQ(stats.connection.cacheWrite.current, 0);
+
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 200);
+    EXPECT_GT(db.MemoryStats().connection.cacheHit.current, 0);
+}
+
+// 測試定期取樣
+TEST_F(MemoryStatsTest, PeriodicSampler) {
+    std::atomic<int> samples = 0;
+    std::atomic<int64_t> lastMemoryUsed = 0;
+    {
+        auto sampler = db.SampleMemoryStats(std::chrono::milliseconds(5), [&](const GlobalMemoryStats &stats) {
+            lastMemoryUsed = stats.memoryUsed.current;
+            ++samples;
+        });
+        for (int i = 0; i < 400 && samples < 3; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    auto count = samples.load();
+    EXPECT_GE(count, 3);
+    EXPECT_GT(lastMemoryUsed.load(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(samples.load(), count);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ 連線設定測試 ============
+
+class OpenOptionsTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試開啟時設定 mmap_size 並讀回實際值
+TEST_F(OpenOptionsTest, MmapSize) {
+    Database db{"test_database.db", OpenOptions{.mmapSize = 64 << 20}, UserTableDefinition};
+    EXPECT_EQ(db.GetMmapSize(), 64 << 20);
+
+    auto &userTable = db.GetTable<decltype(UserTableDefinition)>();
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Alice", 25);
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 1);
+
+    EXPECT_EQ(db.SetMmapSize(0), 0);
+}
+
+// 測試未指定時沿用 SQLite 預設值
+TEST_F(OpenOptionsTest, DefaultMmapSize) {
+    Database db{"test_database.db", UserTableDefinition};
+    Database configured{"test_database.db", OpenOptions{}, UserTableDefinition};
+    EXPECT_EQ(configured.GetMmapSize(), db.GetMmapSize());
+}
+
+// 測試以唯讀模式開啟
+TEST_F(OpenOptionsTest, ReadOnlyFlags) {
+    {
+        Database db{"test_database.db", UserTableDefinition};
+        auto &userTable = db.GetTable<decltype(UserTableDefinition)>();
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Alice", 25);
+    }
+    Database db{"test_database.db", OpenOptions{.flags = SQLITE_OPEN_READONLY}, UserTableDefinition};
+    auto &userTable = db.GetTable<decltype(UserTableDefinition)>();
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 1);
+    EXPECT_ANY_THROW((userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Bob", 30)));
+}
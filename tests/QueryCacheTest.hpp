@@ -0,0 +1,118 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ 查詢結果快取測試 ============
+
+class QueryCacheTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition), decltype(DeptTableDefinition)> db = Database{
+        "test_database.db", UserTableDefinition, DeptTableDefinition
+    };
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+    Table<decltype(DeptTableDefinition)> &deptTable = db.GetTable<decltype(DeptTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        deptTable.Insert<decltype(DeptColumn), decltype(NameColumn)>("IT", "Alice");
+        db.EnableQueryCache(1 << 20);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試相同 SQL 與參數命中快取，不同參數則各自快取
+TEST_F(QueryCacheTest, HitAndMiss) {
+    auto query = [this](int age) {
+        return userTable.Select(userTable[NameColumn])
+                .Where(userTable[AgeColumn] >= MakeParamExpr(age))
+                .CachedResults();
+    };
+    auto first = query(20);
+    auto second = query(20);
+    auto other = query(28);
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(first->size(), 2);
+    EXPECT_EQ(other->size(), 1);
+    auto stats = db.GetQueryCacheStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.entries, 2);
+}
+
+// 測試寫入資料表後只失效讀取該資料表的結果
+TEST_F(QueryCacheTest, InvalidateOnWrite) {
+    auto users = userTable.Select(userTable[NameColumn]).CachedResults();
+    auto depts = deptTable.Select(deptTable[DeptColumn]).CachedResults();
+    EXPECT_EQ(users->size(), 2);
+
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Charlie", 35);
+
+    auto usersAfter = userTable.Select(userTable[NameColumn]).CachedResults();
+    auto deptsAfter = deptTable.Select(deptTable[DeptColumn]).CachedResults();
+    EXPECT_EQ(usersAfter->size(), 3);
+    EXPECT_EQ(users->size(), 2); // 舊結果仍可安全持有
+    EXPECT_EQ(depts.get(), deptsAfter.get());
+    EXPECT_EQ(db.GetQueryCacheStats().invalidations, 1);
+}
+
+// 測試 JOIN 查詢會被任一參與的資料表失效
+TEST_F(QueryCacheTest, InvalidateJoin) {
+    auto query = [this] {
+        return userTable.InnerJoin(deptTable, userTable[NameColumn] == deptTable[NameColumn])
+                .Select(userTable[NameColumn], deptTable[DeptColumn])
+                .CachedResults();
+    };
+    EXPECT_EQ(query()->size(), 1);
+
+    deptTable.Insert<decltype(DeptColumn), decltype(NameColumn)>("HR", "Bob");
+    EXPECT_EQ(query()->size(), 2);
+}
+
+// 測試 ROLLBACK 後不會讀到交易內的結果
+TEST_F(QueryCacheTest, ClearOnRollback) {
+    EXPECT_ANY_THROW(db.CreateTransaction([this] {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Temp", 1);
+        EXPECT_EQ(userTable.Select(userTable[NameColumn]).CachedResults()->size(), 3);
+        throw std::runtime_error("Force rollback");
+    }));
+
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).CachedResults()->size(), 2);
+}
+
+// 測試超過記憶體上限時淘汰最久未使用的結果
+TEST_F(QueryCacheTest, EvictLeastRecentlyUsed) {
+    auto query = [this](int age) {
+        return userTable.Select(userTable[NameColumn], userTable[AgeColumn], userTable[ScoreColumn])
+                .Where(userTable[AgeColumn] >= MakeParamExpr(age))
+                .CachedResults();
+    };
+    query(0);
+    auto entryBytes = db.GetQueryCacheStats().bytes;
+    db.EnableQueryCache(entryBytes * 2);
+
+    query(1);
+    query(2);
+    query(1);
+    query(3);
+
+    auto stats = db.GetQueryCacheStats();
+    EXPECT_EQ(stats.entries, 2);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_LE(stats.bytes, stats.maxBytes);
+    query(1);
+    EXPECT_EQ(db.GetQueryCacheStats().hits, 2);
+}
+
+// 測試未啟用快取時仍回傳實體化結果
+TEST_F(QueryCacheTest, Disabled) {
+    db.DisableQueryCache();
+    auto first = userTable.Select(userTable[NameColumn]).CachedResults();
+    auto second = userTable.Select(userTable[NameColumn]).CachedResults();
+    EXPECT_EQ(first->size(), 2);
+    EXPECT_NE(first.get(), second.get());
+    EXPECT_EQ(db.GetQueryCacheStats().entries, 0);
+}
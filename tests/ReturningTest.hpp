@@ -0,0 +1,113 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ RETURNING 測試 ============
+
+class ReturningTest : public ::testing::Test {
+protected:
+    Column<"id", DataType::INTEGER, ColumnPrimaryKey<OrderType::ASC, ConflictCause::ABORT, true> > IdColumn;
+    Column<"level", DataType::INTEGER, Default<1> > LevelColumn;
+    decltype(MakeTableDefinition<"accounts">(
+        std::make_tuple(IdColumn, NameColumn, LevelColumn)
+    )) AccountsDefinition = MakeTableDefinition<"accounts">(
+        std::make_tuple(IdColumn, NameColumn, LevelColumn)
+    );
+
+    Database<decltype(AccountsDefinition)> db = Database{"test_database.db", AccountsDefinition};
+    Table<decltype(AccountsDefinition)> &accountTable = db.GetTable<decltype(AccountsDefinition)>();
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試 INSERT ... RETURNING 取回自動產生的 id 與預設值
+TEST_F(ReturningTest, InsertReturningGeneratedValues) {
+    auto first = accountTable.Returning(accountTable[IdColumn], accountTable[LevelColumn])
+            .Insert<decltype(NameColumn)>("Alice")
+            .ToVector();
+    ASSERT_EQ(first.size(), 1);
+    EXPECT_EQ(std::get<0>(first[0]), 1);
+    EXPECT_EQ(std::get<1>(first[0]), 1);
+
+    auto second = accountTable.Returning(accountTable[IdColumn])
+            .Insert<decltype(NameColumn), decltype(LevelColumn)>("Bob", 5)
+            .ToVector();
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_EQ(std::get<0>(second[0]), 2);
+}
+
+// 測試 RETURNING 使用運算式
+TEST_F(ReturningTest, InsertReturningExpression) {
+    auto results = accountTable.Returning(accountTable[LevelColumn] * 10_expr)
+            .Insert<decltype(NameColumn), decltype(LevelColumn)>("Alice", 3)
+            .ToVector();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<0>(results[0]), 30);
+}
+
+// 測試 UPSERT ... RETURNING
+TEST_F(ReturningTest, UpsertReturning) {
+    accountTable.Insert<decltype(IdColumn), decltype(NameColumn)>(7, "Alice");
+
+    auto results = accountTable.Returning(accountTable[IdColumn], accountTable[NameColumn])
+            .Upsert<decltype(IdColumn), decltype(NameColumn)>(7, "Alicia")
+            .ToVector();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<0>(results[0]), 7);
+    EXPECT_EQ(std::get<1>(results[0]), "Alicia");
+}
+
+// 測試批量插入 RETURNING
+TEST_F(ReturningTest, InsertManyReturning) {
+    std::vector<std::tuple<std::string> > rows = {{"A"}, {"B"}, {"C"}};
+    auto results = accountTable.Returning(accountTable[IdColumn], accountTable[NameColumn])
+            .InsertMany<decltype(NameColumn)>(rows);
+
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(std::get<0>(results[0]), 1);
+    EXPECT_EQ(std::get<1>(results[2]), "C");
+    EXPECT_EQ(std::get<0>(results[2]), 3);
+}
+
+// 測試 UPDATE ... RETURNING
+TEST_F(ReturningTest, UpdateReturning) {
+    accountTable.Insert<decltype(NameColumn), decltype(LevelColumn)>("Alice", 1);
+    accountTable.Insert<decltype(NameColumn), decltype(LevelColumn)>("Bob", 2);
+    accountTable.Insert<decltype(NameColumn), decltype(LevelColumn)>("Charlie", 3);
+
+    auto results = accountTable.Update<decltype(LevelColumn)>(9)
+            .Where(accountTable[LevelColumn] >= 2_expr)
+            .Returning(accountTable[NameColumn], accountTable[LevelColumn])
+            .ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    for (auto &[name, level]: results) {
+        EXPECT_NE(name, "Alice");
+        EXPECT_EQ(level, 9);
+    }
+}
+
+// 測試 DELETE ... RETURNING
+TEST_F(ReturningTest, DeleteReturning) {
+    accountTable.Insert<decltype(NameColumn)>("Alice");
+    accountTable.Insert<decltype(NameColumn)>("Bob");
+
+    auto deleted = accountTable.Delete()
+            .Where(accountTable[NameColumn] == "Bob"_expr)
+            .Returning(accountTable[IdColumn])
+            .ToVector();
+    ASSERT_EQ(deleted.size(), 1);
+    EXPECT_EQ(std::get<0>(deleted[0]), 2);
+
+    auto remaining = accountTable.Select(accountTable[NameColumn]).Results().ToVector();
+    ASSERT_EQ(remaining.size(), 1);
+}
+
+// 測試 RETURNING 語句發生錯誤時會拋出例外
+TEST_F(ReturningTest, ReturningConstraintViolationThrows) {
+    accountTable.Insert<decltype(IdColumn), decltype(NameColumn)>(1, "Alice");
+
+    auto returning = accountTable.Returning(accountTable[IdColumn]);
+    EXPECT_THROW((returning.Insert<decltype(IdColumn), decltype(NameColumn)>(1, "Bob")), std::runtime_error);
+}
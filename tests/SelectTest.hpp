@@ -260,3 +260,81 @@ TEST_F(SelectTest, OrderByComplexQuery) {
         EXPECT_GE(score, 80.0);
     }
 }
+
+// ============ 多鍵 OrderBy 測試 ============
+TEST_F(SelectTest, OrderByMultipleKeys) {
+    auto results = userTable.Select(userTable[NameColumn], userTable[AgeColumn])
+            .OrderBy(userTable[NameColumn], Desc(userTable[AgeColumn]))
+            .Results()
+            .ToVector();
+
+    ASSERT_EQ(results.size(), 5);
+    EXPECT_EQ(std::get<0>(results[0]), "Alice");
+    EXPECT_EQ(std::get<1>(results[0]), 30);
+    EXPECT_EQ(std::get<0>(results[1]), "Alice");
+    EXPECT_EQ(std::get<1>(results[1]), 25);
+    EXPECT_EQ(std::get<0>(results[2]), "Bob");
+}
+
+TEST_F(SelectTest, OrderByNullsFirstAndLast) {
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("NoScore", 50);
+
+    auto nullsFirst = userTable.Select(userTable[NameColumn])
+            .OrderBy(Desc(userTable[ScoreColumn]).NullsFirst())
+            .Results()
+            .ToVector();
+    ASSERT_EQ(nullsFirst.size(), 6);
+    EXPECT_EQ(std::get<0>(nullsFirst[0]), "NoScore");
+    EXPECT_EQ(std::get<0>(nullsFirst[1]), "Alice");
+
+    auto nullsLast = userTable.Select(userTable[NameColumn])
+            .OrderBy(Asc(userTable[ScoreColumn]).NullsLast())
+            .Results()
+            .ToVector();
+    ASSERT_EQ(nullsLast.size(), 6);
+    EXPECT_EQ(std::get<0>(nullsLast[0]), "Bob");
+    EXPECT_EQ(std::get<0>(nullsLast[5]), "NoScore");
+}
+
+TEST_F(SelectTest, OrderByCollateNoCase) {
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("bob", 10);
+
+    auto results = userTable.Select(userTable[NameColumn], userTable[AgeColumn])
+            .OrderBy(Asc(userTable[NameColumn]).Collate<"NOCASE">(), userTable[AgeColumn])
+            .Results()
+            .ToVector();
+
+    ASSERT_EQ(results.size(), 6);
+    EXPECT_EQ(std::get<0>(results[2]), "bob");
+    EXPECT_EQ(std::get<0>(results[3]), "Bob");
+    EXPECT_EQ(std::get<0>(results[4]), "User1");
+}
+
+// ============ Count / Exists 測試 ============
+TEST_F(SelectTest, CountAllRows) {
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 5);
+}
+
+TEST_F(SelectTest, CountWithWhere) {
+    auto count = userTable.Select(userTable[NameColumn], userTable[AgeColumn])
+            .Where(userTable[AgeColumn] >= 25_expr)
+            .Count();
+    EXPECT_EQ(count, 4);
+}
+
+TEST_F(SelectTest, CountWithDistinctAndLimit) {
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Distinct().Count(), 4);
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).LimitOffset(2).Count(), 2);
+}
+
+TEST_F(SelectTest, CountWithGroupByAndAggregate) {
+    EXPECT_EQ(userTable.Select(userTable[AgeColumn]).GroupBy(userTable[AgeColumn]).Count(), 4);
+    // 沒有 GROUP BY 的聚合只會產生一列
+    EXPECT_EQ(userTable.Select(Max(userTable[AgeColumn])).Count(), 1);
+}
+
+TEST_F(SelectTest, Exists) {
+    EXPECT_TRUE(userTable.Select(userTable[NameColumn]).Where(userTable[NameColumn] == "Bob"_expr).Exists());
+    EXPECT_FALSE(userTable.Select(userTable[NameColumn]).Where(userTable[AgeColumn] > 100_expr).Exists());
+    EXPECT_FALSE(userTable.Select(userTable[NameColumn]).LimitOffset(1, 10).Exists());
+}
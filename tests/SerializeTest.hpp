@@ -0,0 +1,80 @@
+#pragma once
+#include <fstream>
+#include "Common.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ============ 資料庫映像序列化測試 ============
+
+class SerializeTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{":memory:", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        db.CreateTransaction([this] {
+            for (int i = 0; i < 100; ++i) {
+                userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>(
+                    "User" + std::to_string(i), i, i * 1.5);
+            }
+        });
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試序列化後載入可讀寫的副本，且與原資料庫互不影響
+TEST_F(SerializeTest, RoundTrip) {
+    auto image = db.Serialize();
+    ASSERT_FALSE(image.empty());
+
+    auto copy = decltype(db)::FromImage(image, false, UserTableDefinition);
+    auto &copyTable = copy.GetTable<decltype(UserTableDefinition)>();
+    EXPECT_EQ(copyTable.Select(copyTable[NameColumn]).Count(), 100);
+
+    copyTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Extra", 1);
+    EXPECT_EQ(copyTable.Select(copyTable[NameColumn]).Count(), 101);
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 100);
+}
+
+// 測試唯讀映像拒絕寫入
+TEST_F(SerializeTest, ReadOnlyImage) {
+    auto copy = decltype(db)::FromImage(db.Serialize(), true, UserTableDefinition);
+    auto &copyTable = copy.GetTable<decltype(UserTableDefinition)>();
+    EXPECT_EQ(copyTable.Select(copyTable[AgeColumn]).Where(copyTable[AgeColumn] < 10_expr).Count(), 10);
+    EXPECT_ANY_THROW((copyTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Extra", 1)));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// 測試從 mmap 的檔案映像直接載入而不複製
+TEST_F(SerializeTest, NoCopyFromMappedFile) {
+    auto image = db.Serialize();
+    {
+        std::ofstream file("test_database.db", std::ios::binary);
+        file.write(reinterpret_cast<const char *>(image.data()), static_cast<std::streamsize>(image.size()));
+    }
+    int fd = open("test_database.db", O_RDONLY);
+    ASSERT_GE(fd, 0);
+    void *pMapped = mmap(nullptr, image.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    ASSERT_NE(pMapped, MAP_FAILED);
+    {
+        auto mapped = decltype(db)::FromImageNoCopy(
+            std::span(static_cast<const uint8_t *>(pMapped), image.size()), UserTableDefinition);
+        auto &mappedTable = mapped.GetTable<decltype(UserTableDefinition)>();
+        auto rows = mappedTable.Select(mappedTable[NameColumn], mappedTable[ScoreColumn])
+                .Where(mappedTable[AgeColumn] == 42_expr)
+                .Results().ToVector();
+        ASSERT_EQ(rows.size(), 1);
+        EXPECT_EQ(std::get<0>(rows[0]), "User42");
+        EXPECT_DOUBLE_EQ(std::get<1>(rows[0]), 63.0);
+        EXPECT_EQ(mapped.Serialize(), image);
+    }
+    munmap(pMapped, image.size());
+}
+#endif
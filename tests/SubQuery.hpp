@@ -1,6 +1,12 @@
 #pragma once
 #include "Common.hpp"
 
+template<typename Lhs, typename Rhs>
+concept CanIn = requires(const Lhs &left, const Rhs &right) { In(left, right); };
+
+template<typename SubQuery>
+concept CanExists = requires(const SubQuery &subQuery) { Exists(subQuery); };
+
 class SubQueryTest : public ::testing::Test {
 protected:
     Column<"id", DataType::INTEGER, ColumnPrimaryKey<OrderType::ASC, ConflictCause::ABORT, true> > IdColumn;
@@ -60,3 +66,52 @@ TEST_F(SubQueryTest, SimpleSubQuery) {
 
     ASSERT_EQ(results.size(), 2);
 }
+
+// 測試相關子查詢的 EXISTS/NOT EXISTS，子查詢的參數併入外層語句
+TEST_F(SubQueryTest, CorrelatedExists) {
+    userTable.Insert<decltype(NameColumn)>("Carol");
+
+    auto buyers = userTable.Select(userTable[NameColumn])
+            .Where(Exists(orderTable.Select(orderTable[IdColumn])
+                .Where(orderTable[UserColumn] == userTable[IdColumn] && orderTable[PriceColumn] > 120.0_expr)))
+            .Results().ToVector();
+    ASSERT_EQ(buyers.size(), 2);
+    EXPECT_EQ(std::get<0>(buyers[0]), "Alice");
+    EXPECT_EQ(std::get<0>(buyers[1]), "Bob");
+
+    auto others = userTable.Select(userTable[NameColumn])
+            .Where(userTable[NameColumn] != "Alice"_expr
+                   && NotExists(orderTable.Select(orderTable[IdColumn])
+                       .Where(orderTable[UserColumn] == userTable[IdColumn])))
+            .Results().ToVector();
+    ASSERT_EQ(others.size(), 1);
+    EXPECT_EQ(std::get<0>(others[0]), "Carol");
+}
+
+// 測試 IN/NOT IN 子查詢與純量子查詢
+TEST_F(SubQueryTest, InAndScalarSubQuery) {
+    userTable.Insert<decltype(NameColumn)>("Carol");
+
+    auto withOrders = userTable.Select(userTable[NameColumn])
+            .Where(In(userTable[IdColumn], orderTable.Select(orderTable[UserColumn])
+                .Where(orderTable[PriceColumn] >= 150.0_expr)))
+            .Results().ToVector();
+    ASSERT_EQ(withOrders.size(), 2);
+
+    auto withoutOrders = userTable.Select(userTable[NameColumn])
+            .Where(NotIn(userTable[IdColumn], orderTable.Select(orderTable[UserColumn])))
+            .Results().ToVector();
+    ASSERT_EQ(withoutOrders.size(), 1);
+    EXPECT_EQ(std::get<0>(withoutOrders[0]), "Carol");
+
+    // IN/EXISTS 的右側只接受子查詢，一般運算式不會產生 "IN ?" 這類錯誤的 SQL
+    static_assert(!CanIn<decltype(userTable[IdColumn]), decltype(1_expr)>);
+    static_assert(!CanExists<decltype(userTable[IdColumn] > 1_expr)>);
+
+    // 高於平均金額的訂單
+    auto expensive = orderTable.Select(orderTable[PriceColumn])
+            .Where(orderTable[PriceColumn] > orderTable.Select(Avg(orderTable[PriceColumn])))
+            .Results().ToVector();
+    ASSERT_EQ(expensive.size(), 1);
+    EXPECT_DOUBLE_EQ(std::get<0>(expensive[0]), 200.0);
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "Common.hpp"
+
+// ============ 暫存表測試 ============
+
+inline auto StagedTableDefinition = MakeTableDefinition<"staged">(std::make_tuple(NameColumn, ScoreColumn));
+inline auto StagedKeysTableDefinition = MakeTableDefinition<"staged_keys">(std::make_tuple(NameColumn));
+
+class TempTableTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("David", 40, 88.0);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試 InsertMany 後與資料表 Join
+TEST_F(TempTableTest, InsertManyAndJoin) {
+    auto staged = db.TempTable<decltype(StagedTableDefinition)>(TempStore::MEMORY);
+    staged.InsertMany<decltype(NameColumn), decltype(ScoreColumn)>({{"Bob", 1.0}, {"David", 2.0}});
+
+    auto results = userTable.InnerJoin(staged, userTable[NameColumn] == staged[NameColumn])
+            .Select(userTable[NameColumn], userTable[AgeColumn])
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Bob");
+    EXPECT_EQ(std::get<0>(results[1]), "David");
+}
+
+// 測試以暫存的鍵值批次刪除
+TEST_F(TempTableTest, BulkDelete) {
+    auto staged = db.TempTable<decltype(StagedTableDefinition)>();
+    staged.InsertMany<decltype(NameColumn)>({{"Alice"}, {"Charlie"}});
+
+    userTable.Delete().Where(In(userTable[NameColumn], staged.Select(staged[NameColumn]))).Execute();
+
+    EXPECT_EQ(userTable.Select(userTable[NameColumn]).Count(), 2);
+}
+
+// 測試以 UPDATE ... FROM 批次更新
+TEST_F(TempTableTest, BulkUpdateFrom) {
+    auto staged = db.TempTable<decltype(StagedTableDefinition)>();
+    staged.InsertMany<decltype(NameColumn), decltype(ScoreColumn)>({{"Alice", 100.0}, {"Bob", 50.0}});
+
+    userTable.Update(Set(userTable[ScoreColumn], staged[ScoreColumn]))
+            .From(staged)
+            .Where(userTable[NameColumn] == staged[NameColumn])
+            .Execute();
+
+    auto results = userTable.Select(userTable[NameColumn], userTable[ScoreColumn]).Results().ToVector();
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 100.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 50.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[2]), 78.5);
+}
+
+// 測試離開作用域時 DROP，且只存在於 temp schema
+TEST_F(TempTableTest, DroppedOnScopeExit) {
+    {
+        auto staged = db.TempTable<decltype(StagedTableDefinition)>();
+        staged.Insert<decltype(NameColumn)>("Alice");
+        EXPECT_ANY_THROW(db.TempTable<decltype(StagedTableDefinition)>());
+    }
+    auto staged = db.TempTable<decltype(StagedTableDefinition)>();
+    EXPECT_EQ(staged.Select(staged[NameColumn]).Count(), 0);
+
+    // 其他連線看不到暫存表
+    Database other{"test_database.db", StagedTableDefinition};
+    auto &mainStaged = other.GetTable<decltype(StagedTableDefinition)>();
+    EXPECT_EQ(mainStaged.Select(mainStaged[NameColumn]).Count(), 0);
+}
+
+// 測試 DROP 後清除查詢快取，同名的新暫存表不會讀到舊結果
+TEST_F(TempTableTest, DropClearsQueryCache) {
+    db.EnableQueryCache(1 << 20);
+    {
+        auto staged = db.TempTable<decltype(StagedTableDefinition)>();
+        staged.Insert<decltype(NameColumn)>("Alice");
+        EXPECT_EQ(staged.Select(staged[NameColumn]).CachedResults()->size(), 1);
+    }
+    auto staged = db.TempTable<decltype(StagedTableDefinition)>();
+    EXPECT_EQ(staged.Select(staged[NameColumn]).CachedResults()->size(), 0);
+}
+
+// 測試已有暫存表時不能改變 temp_store，否則整個 temp schema 會被捨棄
+TEST_F(TempTableTest, TempStoreChangeRejectedWhileTablesExist) {
+    {
+        auto staged = db.TempTable<decltype(StagedTableDefinition)>(TempStore::MEMORY);
+        staged.Insert<decltype(NameColumn)>("Alice");
+
+        auto keys = db.TempTable<decltype(StagedKeysTableDefinition)>(TempStore::MEMORY);
+        keys.Insert<decltype(NameColumn)>("Bob");
+        EXPECT_THROW(db.TempTable<decltype(StagedKeysTableDefinition)>(TempStore::FILE), std::logic_error);
+
+        EXPECT_EQ(staged.Select(staged[NameColumn]).Count(), 1);
+        EXPECT_EQ(keys.Select(keys[NameColumn]).Count(), 1);
+    }
+    // 所有暫存表都已 DROP，可以改變設定
+    auto keys = db.TempTable<decltype(StagedKeysTableDefinition)>(TempStore::FILE);
+    keys.Insert<decltype(NameColumn)>("Carol");
+    EXPECT_EQ(keys.Select(keys[NameColumn]).Count(), 1);
+}
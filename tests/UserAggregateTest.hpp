@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>
+#include <optional>
+#include <set>
+#include "Common.hpp"
+
+// ============ 自訂聚合與視窗函式測試 ============
+
+// 分數的全距，沒有資料時為 NULL
+struct ScoreRange {
+    std::optional<double> min;
+    std::optional<double> max;
+
+    void Step(double score) {
+        min = std::min(min.value_or(score), score);
+        max = std::max(max.value_or(score), score);
+    }
+
+    std::optional<double> Final() const {
+        if (!min) {
+            return std::nullopt;
+        }
+        return *max - *min;
+    }
+};
+
+// 可在視窗中增減的平方和
+struct SumOfSquares {
+    double total = 0;
+
+    void Step(double value) {
+        total += value * value;
+    }
+
+    void Inverse(double value) {
+        total -= value * value;
+    }
+
+    double Value() const {
+        return total;
+    }
+
+    double Final() const {
+        return total;
+    }
+};
+
+// 不重複的字串數量
+struct DistinctNames {
+    std::set<std::string> names;
+
+    void Step(const std::string &name) {
+        if (name == "Invalid") {
+            throw std::invalid_argument("invalid name");
+        }
+        names.insert(name);
+    }
+
+    int Final() const {
+        return static_cast<int>(names.size());
+    }
+};
+
+template<typename T>
+concept HasOver = requires(const T &function) { function.Over(); };
+
+class UserAggregateTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 25, 78.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 30, 90.0);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試自訂聚合搭配 GroupBy
+TEST_F(UserAggregateTest, GroupBy) {
+    auto range = db.RegisterAggregate<"score_range", ScoreRange>();
+
+    auto results = userTable.Select(userTable[AgeColumn], range(userTable[ScoreColumn]))
+            .GroupBy(userTable[AgeColumn]).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), 25);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 7.0);
+    EXPECT_EQ(std::get<0>(results[1]), 30);
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 2.0);
+}
+
+// 測試自訂聚合搭配 FILTER；沒有 Inverse/Value 時不提供 Over
+TEST_F(UserAggregateTest, Filter) {
+    auto range = db.RegisterAggregate<"score_range", ScoreRange>();
+    static_assert(!HasOver<decltype(range(userTable[ScoreColumn]))>);
+
+    auto results = userTable.Select(range(userTable[ScoreColumn]).Filter(userTable[NameColumn] == "Alice"_expr))
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_DOUBLE_EQ(std::get<0>(results[0]), 4.5);
+}
+
+// 測試沒有任何列時以預設狀態呼叫 Final
+TEST_F(UserAggregateTest, EmptyInput) {
+    auto range = db.RegisterAggregate<"score_range", ScoreRange>();
+
+    auto results = userTable.Select(Coalesce(range(userTable[ScoreColumn]), "none"_expr))
+            .Where(userTable[AgeColumn] > 100_expr).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<0>(results[0]), "none");
+}
+
+// 測試字串參數與整數結果
+TEST_F(UserAggregateTest, DistinctStrings) {
+    auto distinctNames = db.RegisterAggregate<"distinct_names", DistinctNames>();
+
+    auto results = userTable.Select(distinctNames(userTable[NameColumn])).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<0>(results[0]), 3);
+}
+
+// 測試 Step 拋出的例外轉為 SQL 錯誤
+TEST_F(UserAggregateTest, ExceptionBecomesSqlError) {
+    auto distinctNames = db.RegisterAggregate<"distinct_names", DistinctNames>();
+    userTable.Insert<decltype(NameColumn), decltype(AgeColumn)>("Invalid", 1);
+
+    EXPECT_ANY_THROW(userTable.Select(distinctNames(userTable[NameColumn])).Results().ToVector());
+}
+
+// 測試自訂聚合作為視窗函式，搭配 PartitionedBy 與 OrderBy
+TEST_F(UserAggregateTest, WindowFunction) {
+    auto sumOfSquares = db.RegisterAggregate<"sum_of_squares", SumOfSquares>();
+
+    auto results = userTable.Select(
+        userTable[NameColumn],
+        sumOfSquares(userTable[AgeColumn]).PartitionedBy(userTable[NameColumn]),
+        sumOfSquares(userTable[AgeColumn]).OrderBy(userTable[ScoreColumn])
+    ).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 4);
+    for (const auto &[name, perName, running]: results) {
+        if (name == "Alice") {
+            EXPECT_DOUBLE_EQ(perName, 25.0 * 25 + 30 * 30);
+        } else if (name == "Charlie") {
+            EXPECT_DOUBLE_EQ(perName, 625.0);
+            EXPECT_DOUBLE_EQ(running, 625.0); // 分數最低
+        } else if (name == "Bob") {
+            EXPECT_DOUBLE_EQ(running, 625.0 * 2 + 900 * 2); // 分數最高，包含所有列
+        }
+    }
+}
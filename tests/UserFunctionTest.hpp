@@ -0,0 +1,96 @@
+#pragma once
+#include <optional>
+#include <string_view>
+#include "Common.hpp"
+
+// ============ 自訂函式測試 ============
+
+class UserFunctionTest : public ::testing::Test {
+protected:
+    Database<decltype(UserTableDefinition)> db = Database{"test_database.db", UserTableDefinition};
+    Table<decltype(UserTableDefinition)> &userTable = db.GetTable<decltype(UserTableDefinition)>();
+
+    void SetUp() override {
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Alice", 25, 85.5);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Bob", 30, 92.0);
+        userTable.Insert<decltype(NameColumn), decltype(AgeColumn), decltype(ScoreColumn)>("Charlie", 35, 78.5);
+    }
+
+    void TearDown() override {
+        std::remove("test_database.db");
+    }
+};
+
+// 測試在 Select 中使用字串函式
+TEST_F(UserFunctionTest, SelectStringFunction) {
+    auto reverse = db.RegisterFunction<"reverse_text">([](std::string_view text) {
+        return std::string(text.rbegin(), text.rend());
+    });
+
+    auto results = userTable.Select(userTable[NameColumn], reverse(userTable[NameColumn]))
+            .Where(userTable[NameColumn] == "Alice"_expr).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<1>(results[0]), "ecilA");
+}
+
+// 測試在 Where 中使用多參數函式
+TEST_F(UserFunctionTest, WhereMultipleArguments) {
+    auto weighted = db.RegisterFunction<"weighted">([](int age, double score) {
+        return age * 0.5 + score;
+    });
+
+    auto results = userTable.Select(userTable[NameColumn], weighted(userTable[AgeColumn], userTable[ScoreColumn]))
+            .Where(weighted(userTable[AgeColumn], userTable[ScoreColumn]) > 97_expr).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(std::get<0>(results[0]), "Alice");
+    EXPECT_DOUBLE_EQ(std::get<1>(results[0]), 98.0);
+    EXPECT_EQ(std::get<0>(results[1]), "Bob");
+    EXPECT_DOUBLE_EQ(std::get<1>(results[1]), 107.0);
+}
+
+// 測試 std::optional 對應 NULL 參數與回傳值
+TEST_F(UserFunctionTest, OptionalMapsToNull) {
+    userTable.Insert<decltype(AgeColumn)>(40);
+    auto initial = db.RegisterFunction<"initial">([](std::optional<std::string> name) -> std::optional<std::string> {
+        if (!name || name->empty()) {
+            return std::nullopt;
+        }
+        return name->substr(0, 1);
+    });
+
+    auto results = userTable.Select(userTable[AgeColumn], Coalesce(initial(userTable[NameColumn]), "?"_expr))
+            .Results().ToVector();
+
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(std::get<1>(results[0]), "A");
+    EXPECT_EQ(std::get<1>(results[3]), "?");
+}
+
+// 測試函式物件可保有狀態，且可以沒有參數
+TEST_F(UserFunctionTest, StatefulFunction) {
+    int calls = 0;
+    auto counter = db.RegisterFunction<"next_counter">([&calls]() { return ++calls; },
+                                                       FunctionOptions{.deterministic = false});
+
+    auto results = userTable.Select(userTable[NameColumn], counter()).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(std::get<1>(results[2]), 3);
+    EXPECT_EQ(calls, 3);
+}
+
+// 測試函式拋出的例外轉為 SQL 錯誤
+TEST_F(UserFunctionTest, ExceptionBecomesSqlError) {
+    auto checked = db.RegisterFunction<"checked_age">([](int age) {
+        if (age > 30) {
+            throw std::invalid_argument("age out of range");
+        }
+        return age;
+    });
+
+    EXPECT_NO_THROW(userTable.Select(checked(userTable[AgeColumn]))
+        .Where(userTable[AgeColumn] <= 30_expr).Results().ToVector());
+    EXPECT_ANY_THROW(userTable.Select(checked(userTable[AgeColumn])).Results().ToVector());
+}
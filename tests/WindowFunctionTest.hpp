@@ -422,3 +422,135 @@ TEST_F(WindowFunctionTest, MultiplePartitionColumns) {
     }
 }
 
+
+// 測試 ROW_NUMBER 使用多鍵排序
+TEST_F(WindowFunctionTest, RowNumberWithMultipleOrderKeys) {
+    auto results = userTable.Select(
+        userTable[NameColumn],
+        RowNumber().OrderBy(Desc(userTable[AgeColumn]), userTable[NameColumn])
+    ).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 6);
+    for (const auto& row : results) {
+        auto name = std::get<0>(row);
+        auto row_num = std::get<1>(row);
+
+        if (name == "David") {
+            EXPECT_EQ(row_num, 1);
+        } else if (name == "Bob") {
+            EXPECT_EQ(row_num, 2);
+        } else if (name == "Eve") {
+            EXPECT_EQ(row_num, 3);
+        } else if (name == "Alice") {
+            EXPECT_EQ(row_num, 5);
+        } else if (name == "Charlie") {
+            EXPECT_EQ(row_num, 6);
+        }
+    }
+}
+
+// 測試 ROWS 框架：整個分割與前後各一列
+TEST_F(WindowFunctionTest, RowsFrame) {
+    auto results = userTable.Select(
+        userTable[NameColumn],
+        LastValue(userTable[NameColumn]).OrderBy(userTable[ScoreColumn], OrderType::ASC)
+        .Rows(UnboundedPreceding(), UnboundedFollowing()),
+        FirstValue(userTable[NameColumn]).OrderBy(userTable[ScoreColumn], OrderType::ASC)
+        .Rows(Preceding(1), Following(1))
+    ).OrderBy(userTable[ScoreColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 6);
+    // 分數排序：Charlie, Frank, Alice, David, Bob, Eve
+    for (const auto &row: results) {
+        EXPECT_EQ(std::get<1>(row), "Eve");
+    }
+    EXPECT_EQ(std::get<2>(results[0]), "Charlie");
+    EXPECT_EQ(std::get<2>(results[1]), "Charlie");
+    EXPECT_EQ(std::get<2>(results[2]), "Frank");
+    EXPECT_EQ(std::get<2>(results[5]), "Bob");
+}
+
+// 測試 EXCLUDE CURRENT ROW
+TEST_F(WindowFunctionTest, FrameExcludeCurrentRow) {
+    auto results = userTable.Select(
+        userTable[NameColumn],
+        LastValue(userTable[NameColumn]).OrderBy(userTable[ScoreColumn], OrderType::ASC)
+        .Rows(UnboundedPreceding(), CurrentRow(), FrameExclude::CURRENT_ROW)
+    ).OrderBy(userTable[ScoreColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 6);
+    EXPECT_EQ(std::get<1>(results[0]), "");
+    EXPECT_EQ(std::get<1>(results[1]), "Charlie");
+    EXPECT_EQ(std::get<1>(results[5]), "Bob");
+}
+
+// 測試 RANGE 與 GROUPS 框架
+TEST_F(WindowFunctionTest, RangeAndGroupsFrame) {
+    auto results = userTable.Select(
+        userTable[AgeColumn],
+        FirstValue(userTable[AgeColumn]).OrderBy(userTable[AgeColumn], OrderType::ASC)
+        .Range(Preceding(4), CurrentRow()),
+        FirstValue(userTable[AgeColumn]).OrderBy(userTable[AgeColumn], OrderType::ASC)
+        .Groups(Preceding(1), CurrentRow())
+    ).OrderBy(userTable[AgeColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 6);
+    // 年齡排序：25, 25, 28, 30, 30, 35
+    EXPECT_EQ(std::get<1>(results[0]), 25);
+    EXPECT_EQ(std::get<1>(results[2]), 25);
+    EXPECT_EQ(std::get<1>(results[3]), 28);
+    EXPECT_EQ(std::get<1>(results[5]), 35);
+    EXPECT_EQ(std::get<2>(results[1]), 25);
+    EXPECT_EQ(std::get<2>(results[3]), 28);
+    EXPECT_EQ(std::get<2>(results[5]), 30);
+}
+
+// 測試多個視窗函式共用 WINDOW 子句的具名視窗
+TEST_F(WindowFunctionTest, NamedWindow) {
+    auto byScore = Window<"by_score">().OrderBy(userTable[ScoreColumn], OrderType::DESC);
+    auto query = userTable.Select(
+        userTable[NameColumn],
+        RowNumber().Over(byScore),
+        Lag(userTable[NameColumn]).Over(byScore)
+    ).Window(byScore).OrderBy(userTable[ScoreColumn], OrderType::DESC);
+
+    auto results = query.Results().ToVector();
+    ASSERT_EQ(results.size(), 6);
+    EXPECT_EQ(std::get<0>(results[0]), "Eve");
+    EXPECT_EQ(std::get<1>(results[0]), 1);
+    EXPECT_EQ(std::get<2>(results[0]), "");
+    EXPECT_EQ(std::get<0>(results[1]), "Bob");
+    EXPECT_EQ(std::get<1>(results[1]), 2);
+    EXPECT_EQ(std::get<2>(results[1]), "Eve");
+}
+
+// 測試以 OVER (name ORDER BY ... ROWS ...) 延伸具名視窗
+TEST_F(WindowFunctionTest, ExtendNamedWindow) {
+    auto all = Window<"all_rows">();
+    auto byScore = Window<"by_score">().OrderBy(userTable[ScoreColumn], OrderType::ASC);
+    auto results = userTable.Select(
+        userTable[NameColumn],
+        FirstValue(userTable[NameColumn]).OrderBy(userTable[ScoreColumn], OrderType::DESC).Over(all),
+        FirstValue(userTable[NameColumn]).Rows(Preceding(1), CurrentRow()).Over(byScore)
+    ).Window(all, byScore).OrderBy(userTable[ScoreColumn], OrderType::ASC).Results().ToVector();
+
+    ASSERT_EQ(results.size(), 6);
+    // 分數排序：Charlie, Frank, Alice, David, Bob, Eve
+    for (const auto &row: results) {
+        EXPECT_EQ(std::get<1>(row), "Eve");
+    }
+    EXPECT_EQ(std::get<2>(results[0]), "Charlie");
+    EXPECT_EQ(std::get<2>(results[1]), "Charlie");
+    EXPECT_EQ(std::get<2>(results[2]), "Frank");
+    EXPECT_EQ(std::get<2>(results[5]), "Bob");
+}
+
+// 測試不合法的框架：負數位移，以及延伸已有框架的具名視窗
+TEST_F(WindowFunctionTest, InvalidFrame) {
+    EXPECT_THROW(Preceding(-1), std::invalid_argument);
+    EXPECT_THROW(Following(-0.5), std::invalid_argument);
+
+    auto framed = Window<"framed">().Rows(UnboundedPreceding(), CurrentRow());
+    EXPECT_THROW(FirstValue(userTable[NameColumn]).OrderBy(userTable[ScoreColumn], OrderType::ASC).Over(framed),
+                 std::logic_error);
+}
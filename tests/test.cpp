@@ -19,6 +19,24 @@
 #include "ScalarFunctionsTest.hpp"
 #include "DateTimeFunctionsTest.hpp"
 #include "SubQuery.hpp"
+#include "ReturningTest.hpp"
+#include "InsertSelectTest.hpp"
+#include "QueryCacheTest.hpp"
+#include "ChangeStreamTest.hpp"
+#include "ChangesetTest.hpp"
+#include "BackupTest.hpp"
+#include "SerializeTest.hpp"
+#include "OpenOptionsTest.hpp"
+#include "ConfigureTest.hpp"
+#include "MemoryStatsTest.hpp"
+#include "UserFunctionTest.hpp"
+#include "UserAggregateTest.hpp"
+#include "ContainerTableTest.hpp"
+#include "ArrayInTest.hpp"
+#include "TempTableTest.hpp"
+#include "CteTest.hpp"
+#include "CompoundSelectTest.hpp"
+#include "CaseTest.hpp"
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);